@@ -0,0 +1,238 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "cqueue.h"
+#include "dcqueue.h"
+#include "histogram.h"
+#include "queue.h"
+#include "ringlist.h"
+#include "stack.h"
+
+// Throughput and latency of the queue and stack containers against the
+// standard library, one CSV row per container, element size, depth and
+// workload. Meaningful numbers need an optimized build (CMAKE_BUILD_TYPE=Release).
+
+using namespace std;
+
+// A multiple of Batch, so every reported operation was timed and none beyond
+static long long Operations = 1 << 20;
+// Operations timed together, latency is reported per operation of a batch
+static const int Batch = 64;
+
+static volatile unsigned char sink;
+
+template<size_t Size>
+struct TPayload {
+    unsigned char bytes[Size];
+
+    TPayload() = default;
+    explicit TPayload(long long seed)
+    {
+        memset(bytes, static_cast<int>(seed), Size);
+    }
+};
+
+// Ring that wraps its indices with a division after every operation, the way
+// TCircularQueue did before it switched to a compare or a mask. Kept as the
+// baseline for the TCircularQueue rows; it checks neither fullness nor emptiness.
+template<class T>
+class TModuloQueue {
+private:
+    std::vector<T> slots;
+    size_t idxBegin = 0;
+    size_t idxEnd = 0;
+public:
+    typedef T value_type;
+
+    explicit TModuloQueue(size_t capacity) : slots(capacity) {}
+
+    template<class U>
+    void push(U&& element)
+    {
+        slots[idxEnd] = std::forward<U>(element);
+        idxEnd = (idxEnd + 1) % slots.size();
+    }
+    void shift() { idxBegin = (idxBegin + 1) % slots.size(); }
+    T& peek() { return slots[idxBegin]; }
+};
+
+// Uniform face of every benchmarked container: put() adds an element,
+// take() removes the next one and look() reads it without removing
+template<class TContainer>
+struct TQueueAdapter {
+    TContainer container;
+
+    explicit TQueueAdapter(size_t depth) : container(depth + 1) {}
+
+    template<class T>
+    void put(T&& element) { container.push(std::forward<T>(element)); }
+    void take() { container.shift(); }
+    const typename TContainer::value_type& look() { return container.peek(); }
+};
+
+template<class TContainer>
+struct TStackAdapter {
+    TContainer container;
+
+    explicit TStackAdapter(size_t depth) : container(depth + 1) {}
+
+    template<class T>
+    void put(T&& element) { container.push(std::forward<T>(element)); }
+    void take() { container.pop(); }
+    const typename TContainer::value_type& look() { return container.top(); }
+};
+
+template<class T>
+struct TStdQueueAdapter {
+    std::queue<T> container;
+
+    explicit TStdQueueAdapter(size_t) {}
+
+    template<class U>
+    void put(U&& element) { container.push(std::forward<U>(element)); }
+    void take() { container.pop(); }
+    const T& look() { return container.front(); }
+};
+
+// std::deque used as a stack, the baseline for TStack
+template<class T>
+struct TStdDequeAdapter {
+    std::deque<T> container;
+
+    explicit TStdDequeAdapter(size_t) {}
+
+    template<class U>
+    void put(U&& element) { container.push_back(std::forward<U>(element)); }
+    void take() { container.pop_back(); }
+    const T& look() { return container.back(); }
+};
+
+struct TResult {
+    double seconds = 0.0;
+    TLatencyHistogram latency;
+};
+
+// Runs body Operations times in timed batches of Batch calls
+template<class TBody>
+TResult measure(TBody body)
+{
+    TResult result;
+    const auto start = chrono::steady_clock::now();
+    for (long long done = 0; done < Operations; done += Batch)
+    {
+        const auto batchStart = chrono::steady_clock::now();
+        for (int i = 0; i < Batch; i++)
+            body(done + i);
+        const auto batchEnd = chrono::steady_clock::now();
+        result.latency.record(chrono::duration_cast<chrono::nanoseconds>(batchEnd - batchStart).count());
+    }
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+static void report(const string& container, size_t size, size_t depth, const char* workload, const TResult& result)
+{
+    cout << container << ',' << size << ',' << depth << ',' << workload << ',' << Operations << ','
+         << result.seconds << ',' << (Operations / result.seconds / 1e6) << ','
+         << static_cast<double>(result.latency.p50()) / Batch << ','
+         << static_cast<double>(result.latency.p99()) / Batch << '\n';
+}
+
+template<class TAdapter, size_t Size>
+void run(const string& container, size_t depth)
+{
+    typedef TPayload<Size> T;
+
+    {
+        // Steady state: one push and one removal per operation at constant depth
+        TAdapter adapter(depth);
+        for (size_t i = 0; i < depth; i++)
+            adapter.put(T(i));
+        report(container, Size, depth, "push_take", measure([&](long long i) {
+            adapter.put(T(i));
+            sink = sink + adapter.look().bytes[0];
+            adapter.take();
+        }));
+    }
+    {
+        // Fill up to depth, then drain, over and over
+        TAdapter adapter(depth);
+        size_t length = 0;
+        bool filling = true;
+        report(container, Size, depth, "fill_drain", measure([&](long long i) {
+            if (filling)
+            {
+                adapter.put(T(i));
+                filling = ++length < depth;
+            }
+            else
+            {
+                adapter.take();
+                filling = --length == 0;
+            }
+        }));
+    }
+    {
+        TAdapter adapter(depth);
+        for (size_t i = 0; i < depth; i++)
+            adapter.put(T(i));
+        report(container, Size, depth, "peek", measure([&](long long) {
+            sink = sink + adapter.look().bytes[Size - 1];
+        }));
+    }
+}
+
+template<size_t Size>
+void run_all(size_t depth)
+{
+    typedef TPayload<Size> T;
+
+    run<TQueueAdapter<TQueue<T>>, Size>("TQueue", depth);
+    run<TQueueAdapter<TBaseQueue<T, TArrayList>>, Size>("TBaseQueue<TArrayList>", depth);
+    run<TQueueAdapter<TBaseQueue<T, TRingList>>, Size>("TBaseQueue<TRingList>", depth);
+    run<TQueueAdapter<TCircularQueue<T>>, Size>("TCircularQueue", depth);
+    run<TQueueAdapter<TCircularQueue<T, true>>, Size>("TCircularQueue<pow2>", depth);
+    run<TQueueAdapter<TModuloQueue<T>>, Size>("modulo ring", depth);
+    run<TQueueAdapter<TDynamicCircularQueue<T>>, Size>("TDynamicCircularQueue", depth);
+    run<TStdQueueAdapter<T>, Size>("std::queue", depth);
+    // A singly linked list walks to its tail to pop, so deep stacks on it take too long
+    if (depth <= 1024)
+        run<TStackAdapter<TStack<T, TLinkedList>>, Size>("TStack<TLinkedList>", depth);
+    run<TStackAdapter<TStack<T, TArrayList>>, Size>("TStack<TArrayList>", depth);
+    run<TStackAdapter<TStack<T, TRingList>>, Size>("TStack<TRingList>", depth);
+    run<TStdDequeAdapter<T>, Size>("std::deque", depth);
+}
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--operations") && i + 1 < argc)
+        {
+            Operations = stoll(argv[++i]);
+        }
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [--operations N]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+    Operations = (Operations + Batch - 1) / Batch * Batch;
+
+    cout << "container,element_bytes,depth,workload,operations,seconds,mops,p50_ns,p99_ns\n";
+
+    for (size_t depth : { 16, 1024, 65536 })
+    {
+        run_all<8>(depth);
+        run_all<64>(depth);
+        run_all<256>(depth);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "spscqueue.h"
+
+// Round trips between two threads over a pair of SPSC queues: the main thread
+// sends a number on one queue and waits for the echo thread to send it back on
+// the other. Every element crosses cores twice, so the time is dominated by
+// how the cache lines holding the queue indices move between them. Compares
+// the packed layout, with both indices on one line, to the padded one. Run the
+// two threads on different cores for meaningful numbers.
+
+using namespace std;
+
+static long long RoundTrips = 1 << 20;
+
+static const size_t Capacity = 64;
+// Failed attempts before a waiting thread gives its core away
+static const int SpinLimit = 1 << 10;
+
+template<class TAttempt>
+void wait_for(TAttempt attempt)
+{
+    for (int spins = 0; !attempt(); )
+    {
+        if (++spins == SpinLimit)
+        {
+            spins = 0;
+            this_thread::yield();
+        }
+    }
+}
+
+template<bool Padded>
+void run(const char* name)
+{
+    TSpscQueue<long long, Padded> ping(Capacity);
+    TSpscQueue<long long, Padded> pong(Capacity);
+
+    thread echo([&]() {
+        for (long long i = 0; i < RoundTrips; i++)
+        {
+            long long element;
+            wait_for([&] { return ping.try_poll(element); });
+            wait_for([&] { return pong.try_push(element); });
+        }
+    });
+
+    const auto start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (long long i = 0; i < RoundTrips; i++)
+    {
+        long long element;
+        wait_for([&] { return ping.try_push(i); });
+        wait_for([&] { return pong.try_poll(element); });
+        checksum += element;
+    }
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    echo.join();
+
+    if (checksum != RoundTrips * (RoundTrips - 1) / 2)
+    {
+        cerr << "checksum mismatch" << endl;
+    }
+
+    const double seconds = elapsed.count();
+    cout << name << ',' << RoundTrips << ',' << seconds << ','
+         << (RoundTrips / seconds / 1e6) << ',' << (seconds / RoundTrips * 1e9) << '\n';
+}
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--round-trips") && i + 1 < argc)
+        {
+            RoundTrips = stoll(argv[++i]);
+        }
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [--round-trips N]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    cout << "layout,round_trips,seconds,mrtps,ns_per_round_trip\n";
+
+    run<false>("packed");
+    run<true>("padded");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "cqueue.h"
+#include "spscqueue.h"
+
+using namespace std;
+
+static const size_t Capacity = 1024;
+static const long long Operations = 1000000;
+
+template<class TQueueAdapter>
+double measure(TQueueAdapter& queue)
+{
+    const auto start = chrono::steady_clock::now();
+
+    thread producer([&queue]() {
+        for (long long i = 0; i < Operations; )
+        {
+            if (queue.try_push(i))
+                i++;
+            else
+                this_thread::yield();
+        }
+    });
+
+    long long checksum = 0;
+    for (long long i = 0; i < Operations; )
+    {
+        long long element;
+        if (queue.try_poll(element))
+        {
+            checksum += element;
+            i++;
+        }
+        else
+        {
+            this_thread::yield();
+        }
+    }
+    producer.join();
+
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    if (checksum != Operations * (Operations - 1) / 2)
+    {
+        cerr << "checksum mismatch" << endl;
+    }
+    return elapsed.count();
+}
+
+class TLockedCircularQueue
+{
+    mutex guard;
+    TCircularQueue<long long> queue { Capacity };
+public:
+    bool try_push(long long element)
+    {
+        lock_guard<mutex> lock(guard);
+        return queue.try_push(element);
+    }
+
+    bool try_poll(long long& element)
+    {
+        lock_guard<mutex> lock(guard);
+        return queue.try_poll(element);
+    }
+};
+
+template<bool Padded>
+struct TSpscAdapter : TSpscQueue<long long, Padded>
+{
+    TSpscAdapter() : TSpscQueue<long long, Padded>(Capacity) {}
+};
+
+template<class TQueueAdapter>
+void report(const char* name)
+{
+    TQueueAdapter queue;
+    const double seconds = measure(queue);
+    cout << name << "," << Operations << "," << seconds << "," << (Operations / seconds / 1e6) << endl;
+}
+
+int main()
+{
+    cout << "queue,operations,seconds,mops" << endl;
+
+    report<TLockedCircularQueue>("TCircularQueue+mutex");
+    report<TSpscAdapter<false>>("TSpscQueue<packed>");
+    report<TSpscAdapter<true>>("TSpscQueue");
+
+    return EXIT_SUCCESS;
+}
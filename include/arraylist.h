@@ -2,16 +2,32 @@
 #define __ARRAYLIST_H__
 
 #include <stdexcept>
+#include <algorithm>
 #include <cassert>
-
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Elements live in raw storage: only the slots in [begin(), end()) hold
+// constructed objects, the reserved rest of the capacity is left uninitialized.
 template<class T>
 class TArrayList {
 private:
     T *pMem;
     size_t capacity;
     size_t length;
+    // Slots before the first element left behind by pop_front()
+    size_t head;
+
+    static T* allocate(size_t count);
+    static void deallocate(T* mem) noexcept;
+    static void destroy(T* first, T* last) noexcept;
 
     void expand_if_needed();
+    void compact();
+    void relocate(size_t new_capacity);
 public:
     typedef T value_type;
 
@@ -33,10 +49,14 @@ public:
     void push_back(const T& element);
     void push_back(T&& element);
 
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+
     void insert(size_t pos, const T& element);
     void insert(size_t pos, T&& element);
 
     void remove(size_t idx);
+    void pop_front();
 
     T& front();
     T& back();
@@ -56,39 +76,75 @@ public:
     void clear();
     void shrink_to_fit();
 
-    void reserve(size_t len) noexcept;
+    void reserve(size_t len);
 
     friend void swap(TArrayList& lhs, TArrayList& rhs) noexcept
     {
         std::swap(lhs.pMem, rhs.pMem);
         std::swap(lhs.capacity, rhs.capacity);
         std::swap(lhs.length, rhs.length);
+        std::swap(lhs.head, rhs.head);
     }
 };
 
 //
 
+template<class T>
+T* TArrayList<T>::allocate(size_t count)
+{
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+}
+
+template<class T>
+void TArrayList<T>::deallocate(T* mem) noexcept
+{
+    ::operator delete(mem, std::align_val_t(alignof(T)));
+}
+
+template<class T>
+void TArrayList<T>::destroy(T* first, T* last) noexcept
+{
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        for (; first != last; first++)
+            first->~T();
+    }
+}
+
 template<class T>
 TArrayList<T>::TArrayList(size_t initial_capacity)
-        : capacity(initial_capacity > 0
-                   ? initial_capacity
-                   : throw std::invalid_argument("Initial list capacity should be greater than 0"))
+        : pMem(allocate(initial_capacity > 0
+                        ? initial_capacity
+                        : throw std::invalid_argument("Initial list capacity should be greater than 0")))
+        , capacity(initial_capacity)
         , length(0)
-        , pMem(new T[initial_capacity])
+        , head(0)
 {}
 
 template<class T>
 TArrayList<T>::TArrayList(const TArrayList &src)
-        : capacity(src.capacity)
+        : pMem(allocate(src.capacity))
+        , capacity(src.capacity)
         , length(src.length)
-        , pMem(new T[src.capacity])
+        , head(0)
 {
-    std::copy(src.pMem, src.pMem + length, pMem);
+    try
+    {
+        std::uninitialized_copy(src.begin(), src.end(), pMem);
+    }
+    catch (...)
+    {
+        deallocate(pMem);
+        throw;
+    }
 }
 
 template<class T>
 TArrayList<T>::TArrayList(TArrayList &&src) noexcept
         : pMem(nullptr)
+        , capacity(0)
+        , length(0)
+        , head(0)
 {
     swap(*this, src);
 }
@@ -96,33 +152,93 @@ TArrayList<T>::TArrayList(TArrayList &&src) noexcept
 template<class T>
 TArrayList<T>::~TArrayList()
 {
-    delete[] pMem;
+    destroy(begin(), end());
+    deallocate(pMem);
 }
 
 template<class T>
 void TArrayList<T>::expand_if_needed()
 {
-    if (length < capacity) return;
+    if (head + length < capacity) return;
+
+    // Reclaim the dead prefix instead of growing while it is at least half of the list
+    if (head >= length && head > 0)
+    {
+        compact();
+        return;
+    }
 
     //
-    const size_t new_capacity = capacity * 2;
+    const size_t new_capacity = capacity > 0 ? capacity * 2 : 1;
     //
 
+    relocate(new_capacity);
+}
+
+template<class T>
+void TArrayList<T>::compact()
+{
+    if (head == 0) return;
+
+    if constexpr (std::is_trivially_copyable<T>::value)
+    {
+        std::memmove(static_cast<void*>(pMem), pMem + head, length * sizeof(T));
+    }
+    else
+    {
+        // Slots below the old head are raw, the ones above it are still alive
+        for (size_t i = 0; i < length; i++)
+        {
+            if (i < head)
+                new (pMem + i) T(std::move(pMem[head + i]));
+            else
+                pMem[i] = std::move(pMem[head + i]);
+        }
+        destroy(pMem + std::max(head, length), pMem + head + length);
+    }
+    head = 0;
+}
+
+template<class T>
+void TArrayList<T>::relocate(size_t new_capacity)
+{
+    assert(new_capacity >= length && "Capacity is too small");
+
+    T *mem = allocate(new_capacity);
+    if constexpr (std::is_trivially_copyable<T>::value)
+    {
+        std::memcpy(static_cast<void*>(mem), begin(), length * sizeof(T));
+    }
+    else
+    {
+        try
+        {
+            std::uninitialized_move(begin(), end(), mem);
+        }
+        catch (...)
+        {
+            deallocate(mem);
+            throw;
+        }
+        destroy(begin(), end());
+    }
+
+    deallocate(pMem);
+    pMem = mem;
     capacity = new_capacity;
-    TArrayList<T> tmp(*this);
-    swap(*this, tmp);
+    head = 0;
 }
 
 template<class T>
 T *TArrayList<T>::begin() const
 {
-    return pMem;
+    return pMem + head;
 }
 
 template<class T>
 T *TArrayList<T>::end() const
 {
-    return pMem + length;
+    return pMem + head + length;
 }
 
 template<class T>
@@ -140,31 +256,41 @@ bool TArrayList<T>::empty() const noexcept
 template<class T>
 void TArrayList<T>::push_back(const T &element)
 {
-    expand_if_needed();
-    pMem[length++] = element;
+    emplace_back(element);
 }
 
 template<class T>
 void TArrayList<T>::push_back(T &&element)
 {
-    push_back(element);
+    emplace_back(std::move(element));
 }
 
 template<class T>
-void TArrayList<T>::insert(size_t pos, const T &element)
+template<typename... Args>
+T& TArrayList<T>::emplace_back(Args&&... args)
 {
-    assert(pos < length && "Index is out of range");
-
     expand_if_needed();
-    std::copy(pMem + pos, pMem + length, pMem + pos + 1);
-    pMem[pos] = element;
+    T *element = new (end()) T(std::forward<Args>(args)...);
     length++;
+    return *element;
+}
+
+template<class T>
+void TArrayList<T>::insert(size_t pos, const T &element)
+{
+    insert(pos, T(element));
 }
 
 template<class T>
 void TArrayList<T>::insert(size_t pos, T &&element)
 {
-    insert(pos, element);
+    assert(pos < length && "Index is out of range");
+
+    expand_if_needed();
+    new (end()) T(std::move(back()));
+    std::move_backward(begin() + pos, end() - 1, end());
+    begin()[pos] = std::move(element);
+    length++;
 }
 
 template<class T>
@@ -172,20 +298,31 @@ void TArrayList<T>::remove(size_t idx)
 {
     assert(idx < length && "Index is out of range");
 
-    std::copy(pMem + idx + 1, pMem + length, pMem + idx);
+    std::move(begin() + idx + 1, end(), begin() + idx);
+    length--;
+    destroy(end(), end() + 1);
+}
+
+template<class T>
+void TArrayList<T>::pop_front()
+{
+    assert(length && "List is empty");
+
+    destroy(begin(), begin() + 1);
     length--;
+    head = length ? head + 1 : 0;
 }
 
 template<class T>
 T &TArrayList<T>::front()
 {
-    return pMem[0];
+    return pMem[head];
 }
 
 template<class T>
 T &TArrayList<T>::back()
 {
-    return pMem[length - 1];
+    return pMem[head + length - 1];
 }
 
 template<class T>
@@ -210,7 +347,7 @@ T &TArrayList<T>::operator[](const size_t idx)
 template<class T>
 const T &TArrayList<T>::operator[](const size_t idx) const
 {
-    return pMem[idx];
+    return pMem[head + idx];
 }
 
 template<class T>
@@ -223,7 +360,7 @@ bool TArrayList<T>::operator==(const TArrayList &other) const noexcept
         return false;
 
     for (size_t i = 0; i < length; i++)
-        if (pMem[i] != other.pMem[i])
+        if ((*this)[i] != other[i])
             return false;
 
     return true;
@@ -256,26 +393,23 @@ TArrayList<T>& TArrayList<T>::operator=(TArrayList &&other) noexcept
 template<class T>
 void TArrayList<T>::clear()
 {
+    destroy(begin(), end());
     length = 0;
+    head = 0;
 }
 
 template<class T>
 void TArrayList<T>::shrink_to_fit()
 {
-    capacity = length;
-    TArrayList<T> tmp(*this);
-    swap(*this, tmp);
+    relocate(length);
 }
 
 template<class T>
-void TArrayList<T>::reserve(size_t len) noexcept
+void TArrayList<T>::reserve(size_t len)
 {
-    if (len < capacity) {
-        capacity = len;
-        TArrayList<T> tmp(*this);
-        swap(*this, tmp);
+    if (len > capacity) {
+        relocate(len);
     }
-    length = len;
 }
 
 #endif // __ARRAYLIST_H__
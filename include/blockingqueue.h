@@ -0,0 +1,317 @@
+#ifndef __BLOCKING_QUEUE_H__
+#define __BLOCKING_QUEUE_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+// Thread-safe wrapper that lets producers wait for room and consumers wait for
+// elements of a bounded single-threaded queue such as TCircularQueue or
+// TBaseQueue. A waiting thread first spins on a copy of the length that needs
+// no lock, then parks on a condition variable. Parked threads are counted and
+// a side signals the other only when the count is non-zero, so while nobody
+// waits a push or a poll is one uncontended lock and no system call.
+template<class TQueue>
+class TBlockingQueue
+{
+public:
+    typedef typename TQueue::value_type value_type;
+private:
+    typedef typename TQueue::value_type T;
+    typedef std::chrono::steady_clock clock;
+
+    // Checks of the length before a waiting thread takes the lock to park
+    static constexpr int SpinLimit = 128;
+
+    TQueue queue;
+    const size_t capacity;
+    // queue.size() as of the last change, read without the lock while spinning
+    std::atomic<size_t> length;
+
+    std::mutex guard;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    // Threads parked on notEmpty and notFull
+    size_t emptyWaiters;
+    size_t fullWaiters;
+
+    static void relax() noexcept;
+
+    template<class TReady>
+    void spin(TReady ready) const noexcept;
+
+    // Waits with the lock held until ready() holds, false if the deadline passes first
+    template<class TReady>
+    bool park(std::unique_lock<std::mutex>& lock, std::condition_variable& condition, size_t& waiters,
+              TReady ready, const clock::time_point* deadline);
+
+    bool wait_for_room(std::unique_lock<std::mutex>& lock, const clock::time_point* deadline);
+    bool wait_for_element(std::unique_lock<std::mutex>& lock, const clock::time_point* deadline);
+
+    template<typename U>
+    bool push_element(U&& element, const clock::time_point* deadline);
+    // Publishes the new length and signals parked threads of the other side, releases the lock
+    void changed(std::unique_lock<std::mutex>& lock, std::condition_variable& condition, size_t waiters);
+
+    template<class Rep, class Period>
+    static clock::time_point deadline_after(const std::chrono::duration<Rep, Period>& timeout);
+public:
+    // Arguments go to the constructor of the wrapped queue
+    template<typename... Args>
+    explicit TBlockingQueue(Args&&... args);
+
+    TBlockingQueue(const TBlockingQueue&) = delete;
+    TBlockingQueue& operator=(const TBlockingQueue&) = delete;
+
+    // Block while the queue is full
+    void push_wait(const T& element);
+    void push_wait(T&& element);
+
+    // Block while the queue is empty
+    [[nodiscard]]
+    T poll_wait();
+
+    // False if the timeout passes before there is room or an element
+    template<class Rep, class Period>
+    bool push_wait_for(const T& element, const std::chrono::duration<Rep, Period>& timeout);
+    template<class Rep, class Period>
+    bool push_wait_for(T&& element, const std::chrono::duration<Rep, Period>& timeout);
+    template<class Rep, class Period>
+    bool poll_wait_for(T& element, const std::chrono::duration<Rep, Period>& timeout);
+
+    // Do not wait at all
+    bool try_push(const T& element);
+    bool try_push(T&& element);
+    bool try_poll(T& element);
+
+    // Snapshots, may be outdated as soon as they return
+    bool full() const noexcept;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    size_t max_size() const noexcept;
+};
+
+//
+
+template<class TQueue>
+template<typename... Args>
+TBlockingQueue<TQueue>::TBlockingQueue(Args&&... args)
+        : queue(std::forward<Args>(args)...)
+        , capacity(queue.max_size())
+        , length(queue.size())
+        , emptyWaiters(0)
+        , fullWaiters(0)
+{}
+
+template<class TQueue>
+void TBlockingQueue<TQueue>::relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#endif
+}
+
+template<class TQueue>
+template<class TReady>
+void TBlockingQueue<TQueue>::spin(TReady ready) const noexcept
+{
+    for (int i = 0; i < SpinLimit && !ready(); i++)
+        relax();
+}
+
+template<class TQueue>
+template<class TReady>
+bool TBlockingQueue<TQueue>::park(std::unique_lock<std::mutex>& lock, std::condition_variable& condition,
+                                  size_t& waiters, TReady ready, const clock::time_point* deadline)
+{
+    bool timedOut = false;
+    waiters++;
+    while (!ready() && !timedOut)
+    {
+        if (deadline)
+            timedOut = condition.wait_until(lock, *deadline) == std::cv_status::timeout;
+        else
+            condition.wait(lock);
+    }
+    waiters--;
+    return ready();
+}
+
+template<class TQueue>
+bool TBlockingQueue<TQueue>::wait_for_room(std::unique_lock<std::mutex>& lock, const clock::time_point* deadline)
+{
+    if (!queue.full())
+        return true;
+
+    lock.unlock();
+    spin([this] { return length.load(std::memory_order_relaxed) < capacity; });
+    lock.lock();
+
+    return park(lock, notFull, fullWaiters, [this] { return !queue.full(); }, deadline);
+}
+
+template<class TQueue>
+bool TBlockingQueue<TQueue>::wait_for_element(std::unique_lock<std::mutex>& lock, const clock::time_point* deadline)
+{
+    if (!queue.empty())
+        return true;
+
+    lock.unlock();
+    spin([this] { return length.load(std::memory_order_relaxed) > 0; });
+    lock.lock();
+
+    return park(lock, notEmpty, emptyWaiters, [this] { return !queue.empty(); }, deadline);
+}
+
+template<class TQueue>
+void TBlockingQueue<TQueue>::changed(std::unique_lock<std::mutex>& lock, std::condition_variable& condition,
+                                     size_t waiters)
+{
+    length.store(queue.size(), std::memory_order_relaxed);
+    lock.unlock();
+
+    if (waiters)
+        condition.notify_one();
+}
+
+template<class TQueue>
+template<typename U>
+bool TBlockingQueue<TQueue>::push_element(U&& element, const clock::time_point* deadline)
+{
+    std::unique_lock<std::mutex> lock(guard);
+    if (!wait_for_room(lock, deadline))
+        return false;
+
+    queue.push(std::forward<U>(element));
+    changed(lock, notEmpty, emptyWaiters);
+    return true;
+}
+
+template<class TQueue>
+template<class Rep, class Period>
+typename TBlockingQueue<TQueue>::clock::time_point
+TBlockingQueue<TQueue>::deadline_after(const std::chrono::duration<Rep, Period>& timeout)
+{
+    return clock::now() + std::chrono::ceil<clock::duration>(timeout);
+}
+
+template<class TQueue>
+void TBlockingQueue<TQueue>::push_wait(const T& element)
+{
+    push_element(element, nullptr);
+}
+
+template<class TQueue>
+void TBlockingQueue<TQueue>::push_wait(T&& element)
+{
+    push_element(std::move(element), nullptr);
+}
+
+template<class TQueue>
+typename TBlockingQueue<TQueue>::T TBlockingQueue<TQueue>::poll_wait()
+{
+    std::unique_lock<std::mutex> lock(guard);
+    wait_for_element(lock, nullptr);
+
+    T element = queue.poll();
+    changed(lock, notFull, fullWaiters);
+    return element;
+}
+
+template<class TQueue>
+template<class Rep, class Period>
+bool TBlockingQueue<TQueue>::push_wait_for(const T& element, const std::chrono::duration<Rep, Period>& timeout)
+{
+    const clock::time_point deadline = deadline_after(timeout);
+    return push_element(element, &deadline);
+}
+
+template<class TQueue>
+template<class Rep, class Period>
+bool TBlockingQueue<TQueue>::push_wait_for(T&& element, const std::chrono::duration<Rep, Period>& timeout)
+{
+    const clock::time_point deadline = deadline_after(timeout);
+    return push_element(std::move(element), &deadline);
+}
+
+template<class TQueue>
+template<class Rep, class Period>
+bool TBlockingQueue<TQueue>::poll_wait_for(T& element, const std::chrono::duration<Rep, Period>& timeout)
+{
+    const clock::time_point deadline = deadline_after(timeout);
+
+    std::unique_lock<std::mutex> lock(guard);
+    if (!wait_for_element(lock, &deadline))
+        return false;
+
+    element = queue.poll();
+    changed(lock, notFull, fullWaiters);
+    return true;
+}
+
+template<class TQueue>
+bool TBlockingQueue<TQueue>::try_push(const T& element)
+{
+    std::unique_lock<std::mutex> lock(guard);
+    if (!queue.try_push(element))
+        return false;
+
+    changed(lock, notEmpty, emptyWaiters);
+    return true;
+}
+
+template<class TQueue>
+bool TBlockingQueue<TQueue>::try_push(T&& element)
+{
+    std::unique_lock<std::mutex> lock(guard);
+    if (!queue.try_push(std::move(element)))
+        return false;
+
+    changed(lock, notEmpty, emptyWaiters);
+    return true;
+}
+
+template<class TQueue>
+bool TBlockingQueue<TQueue>::try_poll(T& element)
+{
+    std::unique_lock<std::mutex> lock(guard);
+    if (!queue.try_poll(element))
+        return false;
+
+    changed(lock, notFull, fullWaiters);
+    return true;
+}
+
+template<class TQueue>
+bool TBlockingQueue<TQueue>::full() const noexcept
+{
+    return length.load(std::memory_order_relaxed) >= capacity;
+}
+
+template<class TQueue>
+bool TBlockingQueue<TQueue>::empty() const noexcept
+{
+    return length.load(std::memory_order_relaxed) == 0;
+}
+
+template<class TQueue>
+size_t TBlockingQueue<TQueue>::size() const noexcept
+{
+    return length.load(std::memory_order_relaxed);
+}
+
+template<class TQueue>
+size_t TBlockingQueue<TQueue>::max_size() const noexcept
+{
+    return capacity;
+}
+
+#endif // __BLOCKING_QUEUE_H__
@@ -0,0 +1,44 @@
+#ifndef __CHAIN_H__
+#define __CHAIN_H__
+
+#include <vector>
+
+#include "cluster.h"
+
+// Stationary solution of the discrete TCluster model. A cycle is a step of a
+// Markov chain over (processor busy, tasks queued), so the long-run shares the
+// simulation converges to can be computed exactly instead of sampled.
+class TClusterChain {
+private:
+    const size_t capacity;
+    const double intensity;
+    const double performance;
+
+    // Probability of (busy, queued) at the end of a cycle, indexed by state()
+    std::vector<double> stationary;
+
+    static size_t state(bool busy, size_t queued) noexcept;
+
+    void solve();
+public:
+    TClusterChain(size_t capacity, double intensity, double performance);
+
+    [[nodiscard]]
+    double probability(bool busy, size_t queued) const;
+
+    [[nodiscard]]
+    double rejection_share() const noexcept;
+    [[nodiscard]]
+    double service_cycles() const noexcept;
+    [[nodiscard]]
+    double idle_share() const noexcept;
+    [[nodiscard]]
+    double completion_rate() const noexcept;
+
+    // Counters a TCluster is expected to report after the given number of cycles,
+    // ignoring the warm-up from an empty queue
+    [[nodiscard]]
+    TPerfStat expected(long long cycles) const noexcept;
+};
+
+#endif // __CHAIN_H__
@@ -1,35 +1,111 @@
 #ifndef __CLUSTER_H__
 #define __CLUSTER_H__
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
 #include "queue.h"
+#include "countingqueue.h"
+#include "histogram.h"
 #include "random.h"
+#include "replay.h"
+#include "trace.h"
+
+struct TPerfStat {
+    long long total_tasks = 0;
+    long long completed_tasks = 0;
+    long long rejected_tasks = 0;
+    long long cycles = 0;
+    long long idle_cycles = 0;
+
+    double rejection_share() const noexcept;
+    double service_cycles() const noexcept;
+    double idle_share() const noexcept;
+
+    TPerfStat& operator+=(const TPerfStat& other) noexcept;
+};
 
-class TCluster {
+struct TClusterTask {
+    long long id = 0;
+    // Cycle the task arrived in, cycles are numbered from 1
+    long long arrival = 0;
+};
+
+// Per-task times in cycles: a task arriving in cycle a, picked up in cycle s
+// and completed in cycle c waited s - a, was served c - s + 1 and spent
+// c - a + 1 cycles in the cluster
+struct TLatencyStat {
+    TLatencyHistogram wait;
+    TLatencyHistogram service;
+    TLatencyHistogram sojourn;
+
+    TLatencyStat& operator+=(const TLatencyStat& other) noexcept;
+};
+
+// Takes the place of TLatencyStat in clusters that do not track latency,
+// so they do not carry the histograms around
+struct TNoLatencyStat {};
+
+// TTaskQueue decides how waiting tasks are kept: TQueue stores every task id,
+// TCountingQueue only tracks how many tasks are waiting. Both produce the same stats.
+// TEngine drives the random draws; std::mt19937 instead of the default xoshiro
+// gives an independent stream to cross-check results with.
+template<template<typename> class TTaskQueue, class TEngine = TXoshiro256>
+class TBasicCluster {
 public:
-    typedef int Task;
-
-    struct PerfStat {
-        int total_tasks = 0;
-        int completed_tasks = 0;
-        int rejected_tasks = 0;
-        int cycles = 0;
-        int idle_cycles = 0;
-    };
+    typedef TClusterTask Task;
+    typedef TPerfStat PerfStat;
+    typedef TRandom<double, TEngine> Random;
+
+    // Latency needs the arrival cycle of every task, which only a queue that stores them has
+    static constexpr bool TracksLatency = !std::is_same<TTaskQueue<Task>, TCountingQueue<Task>>::value;
 private:
-    static const Task IdleTask = -1;
+    static constexpr long long IdleTask = -1;
+    static constexpr long long Never = std::numeric_limits<long long>::max();
 
     PerfStat stat;
+    std::conditional_t<TracksLatency, TLatencyStat, TNoLatencyStat> latencies;
 
     const double intensity;
     const double performance;
 
-    TQueue<Task> tasks;
-    TRandom<double> random;
+    TTaskQueue<Task> tasks;
+    Random random;
+
+    // Integer forms of intensity and performance for TRandom::next_bernoulli()
+    const typename Random::threshold_type arrivalThreshold;
+    const typename Random::threshold_type completionThreshold;
 
     Task current;
-    Task lastId = 0;
+    long long started = 0;
+    long long lastId = 0;
+
+    TTraceWriter* tracer = nullptr;
+
+    // Arrival times drawn from the intensity, what simulate() runs on
+    struct TDrawnArrivals {
+        TBasicCluster& cluster;
+        long long next;
+
+        long long peek() const noexcept { return next; }
+        void pop() { next = cluster.next_event(next, cluster.intensity); }
+    };
+
+    long long next_event(long long after, double probability);
+    // False if there is no task to start
+    bool start_task(long long cycle);
+    void complete_task(long long cycle);
+
+    // Event engine behind simulate() and replay(). TArrivals provides peek(),
+    // the cycle of the next arrival or Never, and pop() to move past it.
+    template<class TArrivals>
+    void advance(long long cycles, TArrivals& arrivals);
 public:
-    TCluster(size_t capacity, double intensity, double performance);
+    TBasicCluster(size_t capacity, double intensity, double performance);
+    TBasicCluster(size_t capacity, double intensity, double performance, const Random& random);
 
     void add_task(const Task& task);
     const Task& get_current_task() const noexcept;
@@ -37,10 +113,309 @@ public:
     void generate_tasks();
     void perform_cycle();
 
+    // Same model as calling generate_tasks() and perform_cycle() once per cycle,
+    // but the clock jumps straight from one arrival or completion to the next
+    void simulate(long long cycles);
+
+    // Same as simulate(), but tasks arrive at the cycles recorded in the file instead
+    // of being drawn; arrivals after the last cycle stay in the file for the next call.
+    // With a seeded TRandom the same log always produces the same stats.
+    void replay(TArrivalFile& arrivals, long long cycles);
+
     size_t get_capacity() const noexcept;
     bool is_idle() const noexcept;
 
     const PerfStat& stats() const noexcept;
+    // Empty unless TracksLatency
+    const TLatencyStat& latency() const noexcept;
+
+    // Every event from now on goes to tracer as well, nullptr stops tracing.
+    // TCountingCluster does not keep task ids, its start and completion events carry 0.
+    void set_tracer(TTraceWriter* tracer) noexcept;
 };
 
+typedef TBasicCluster<TQueue> TCluster;
+typedef TBasicCluster<TCountingQueue> TCountingCluster;
+
+extern template class TBasicCluster<TQueue>;
+extern template class TBasicCluster<TCountingQueue>;
+
+//
+
+inline double TPerfStat::rejection_share() const noexcept
+{
+    return total_tasks ? static_cast<double>(rejected_tasks) / total_tasks : 0.0;
+}
+
+inline double TPerfStat::service_cycles() const noexcept
+{
+    return completed_tasks ? static_cast<double>(cycles - idle_cycles) / completed_tasks : 0.0;
+}
+
+inline double TPerfStat::idle_share() const noexcept
+{
+    return cycles ? static_cast<double>(idle_cycles) / cycles : 0.0;
+}
+
+inline TPerfStat& TPerfStat::operator+=(const TPerfStat& other) noexcept
+{
+    total_tasks += other.total_tasks;
+    completed_tasks += other.completed_tasks;
+    rejected_tasks += other.rejected_tasks;
+    cycles += other.cycles;
+    idle_cycles += other.idle_cycles;
+    return *this;
+}
+
+inline TLatencyStat& TLatencyStat::operator+=(const TLatencyStat& other) noexcept
+{
+    wait += other.wait;
+    service += other.service;
+    sojourn += other.sojourn;
+    return *this;
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+TBasicCluster<TTaskQueue, TEngine>::TBasicCluster(size_t capacity, double intensity, double performance)
+        : TBasicCluster(capacity, intensity, performance, Random(0.0, 1.0))
+{}
+
+template<template<typename> class TTaskQueue, class TEngine>
+TBasicCluster<TTaskQueue, TEngine>::TBasicCluster(size_t capacity, double intensity, double performance,
+                                                  const Random& random)
+        : intensity(intensity)
+        , performance(performance)
+        , tasks(capacity)
+        , random(random)
+        , arrivalThreshold(Random::threshold(intensity))
+        , completionThreshold(Random::threshold(performance))
+        , current{ IdleTask, 0 }
+{}
+
+template<template<typename> class TTaskQueue, class TEngine>
+void TBasicCluster<TTaskQueue, TEngine>::add_task(const Task& task)
+{
+    stat.total_tasks++;
+
+    if (!tasks.try_push(task))
+    {
+        stat.rejected_tasks++;
+        if (tracer)
+            tracer->record(TTraceEvent::Reject, task.arrival, task.id);
+        return;
+    }
+
+    if (tracer)
+        tracer->record(TTraceEvent::Arrival, task.arrival, task.id);
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+const typename TBasicCluster<TTaskQueue, TEngine>::Task&
+TBasicCluster<TTaskQueue, TEngine>::get_current_task() const noexcept
+{
+    return current;
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+void TBasicCluster<TTaskQueue, TEngine>::generate_tasks()
+{
+    if (random.next_bernoulli(arrivalThreshold))
+    {
+        add_task({ ++lastId, stat.cycles + 1 });
+    }
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+void TBasicCluster<TTaskQueue, TEngine>::perform_cycle()
+{
+    stat.cycles++;
+
+    if (current.id == IdleTask && !start_task(stat.cycles))
+    {
+        stat.idle_cycles++;
+        if (tracer)
+            tracer->record_idle(stat.cycles, 1);
+        return;
+    }
+
+    if (!random.next_bernoulli(completionThreshold))
+    {
+        return;
+    }
+
+    complete_task(stat.cycles);
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+bool TBasicCluster<TTaskQueue, TEngine>::start_task(long long cycle)
+{
+    if (!tasks.try_poll(current))
+        return false;
+
+    started = cycle;
+    if (tracer)
+        tracer->record(TTraceEvent::Start, cycle, current.id);
+    return true;
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+void TBasicCluster<TTaskQueue, TEngine>::complete_task(long long cycle)
+{
+    if constexpr (TracksLatency)
+    {
+        latencies.wait.record(started - current.arrival);
+        latencies.service.record(cycle - started + 1);
+        latencies.sojourn.record(cycle - current.arrival + 1);
+    }
+
+    if (tracer)
+        tracer->record(TTraceEvent::Complete, cycle, current.id);
+
+    stat.completed_tasks++;
+    current.id = IdleTask;
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+long long TBasicCluster<TTaskQueue, TEngine>::next_event(long long after, double probability)
+{
+    if (probability >= 1.0)
+    {
+        return after + 1;
+    }
+    if (probability <= 0.0)
+    {
+        return Never;
+    }
+
+    // Number of Bernoulli trials up to and including the first success
+    const double gap = std::floor(std::log(1.0 - random.next()) / std::log1p(-probability));
+    if (gap >= static_cast<double>(Never - after - 1))
+    {
+        return Never;
+    }
+    return after + 1 + static_cast<long long>(gap);
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+void TBasicCluster<TTaskQueue, TEngine>::simulate(long long cycles)
+{
+    TDrawnArrivals arrivals { *this, next_event(stat.cycles, intensity) };
+    advance(cycles, arrivals);
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+void TBasicCluster<TTaskQueue, TEngine>::replay(TArrivalFile& arrivals, long long cycles)
+{
+    advance(cycles, arrivals);
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+template<class TArrivals>
+void TBasicCluster<TTaskQueue, TEngine>::advance(long long cycles, TArrivals& arrivals)
+{
+    if (cycles < 0)
+    {
+        throw std::invalid_argument("Cycle count should not be negative");
+    }
+
+    const long long end = stat.cycles + cycles;
+
+    long long now = stat.cycles;
+    long long completion = current.id == IdleTask ? Never : next_event(now, performance);
+
+    while (now < end)
+    {
+        if (current.id == IdleTask)
+        {
+            if (tasks.empty() && arrivals.peek() > now + 1)
+            {
+                // Nothing to do until the next arrival
+                const long long wakeup = std::min(arrivals.peek() - 1, end);
+                stat.idle_cycles += wakeup - now;
+                if (tracer && wakeup > now)
+                    tracer->record_idle(now + 1, wakeup - now);
+                now = wakeup;
+                continue;
+            }
+
+            // Within a cycle new tasks are queued before the processor picks one.
+            // Replayed arrivals dated before the current cycle come in now.
+            while (arrivals.peek() <= now + 1)
+            {
+                add_task({ ++lastId, now + 1 });
+                arrivals.pop();
+            }
+
+            if (!start_task(now + 1))
+            {
+                // Every task of the cycle was rejected, so it is idle after all
+                stat.idle_cycles++;
+                if (tracer)
+                    tracer->record_idle(now + 1, 1);
+                now++;
+                continue;
+            }
+            completion = next_event(now, performance);
+        }
+
+        const long long horizon = std::min(completion, end);
+        while (arrivals.peek() <= horizon)
+        {
+            add_task({ ++lastId, std::max(arrivals.peek(), now + 1) });
+            arrivals.pop();
+        }
+
+        if (completion > end)
+        {
+            now = end;
+            break;
+        }
+
+        complete_task(completion);
+        now = completion;
+    }
+
+    stat.cycles = end;
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+size_t TBasicCluster<TTaskQueue, TEngine>::get_capacity() const noexcept
+{
+    return tasks.max_size();
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+bool TBasicCluster<TTaskQueue, TEngine>::is_idle() const noexcept
+{
+    return current.id == IdleTask;
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+const typename TBasicCluster<TTaskQueue, TEngine>::PerfStat&
+TBasicCluster<TTaskQueue, TEngine>::stats() const noexcept
+{
+    return stat;
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+const TLatencyStat& TBasicCluster<TTaskQueue, TEngine>::latency() const noexcept
+{
+    if constexpr (TracksLatency)
+    {
+        return latencies;
+    }
+    else
+    {
+        // One for all such clusters, built the first time somebody asks
+        static const TLatencyStat empty;
+        return empty;
+    }
+}
+
+template<template<typename> class TTaskQueue, class TEngine>
+void TBasicCluster<TTaskQueue, TEngine>::set_tracer(TTraceWriter* tracer) noexcept
+{
+    this->tracer = tracer;
+}
+
 #endif //__CLUSTER_H__
@@ -0,0 +1,120 @@
+#ifndef __COUNTING_QUEUE_H__
+#define __COUNTING_QUEUE_H__
+
+#include <stdexcept>
+
+// Bounded queue that keeps track of its occupancy only. Elements are not
+// stored, poll() hands out a value-initialized T, so it fits users that
+// need to know how many elements are queued but never look at them.
+template<typename T>
+class TCountingQueue
+{
+private:
+    const size_t capacity;
+    size_t length;
+
+    void require_not_empty() const;
+public:
+    typedef T value_type;
+
+    explicit TCountingQueue(size_t capacity);
+
+    bool full() const noexcept;
+    bool empty() const noexcept;
+
+    void push(const T& element);
+
+    void shift();
+    [[nodiscard]]
+    T poll();
+
+    bool try_push(const T& element) noexcept;
+    bool try_poll(T& element) noexcept;
+
+    size_t size() const noexcept;
+    size_t max_size() const noexcept;
+};
+
+//
+
+template<typename T>
+TCountingQueue<T>::TCountingQueue(size_t capacity)
+        : capacity(capacity)
+        , length(0)
+{}
+
+template<typename T>
+bool TCountingQueue<T>::full() const noexcept
+{
+    return length == capacity;
+}
+
+template<typename T>
+bool TCountingQueue<T>::empty() const noexcept
+{
+    return length == 0;
+}
+
+template<typename T>
+void TCountingQueue<T>::push(const T&)
+{
+    if (full())
+    {
+        throw std::overflow_error("Queue is full");
+    }
+    length++;
+}
+
+template<typename T>
+void TCountingQueue<T>::shift()
+{
+    require_not_empty();
+    length--;
+}
+
+template<typename T>
+T TCountingQueue<T>::poll()
+{
+    shift();
+    return T();
+}
+
+template<typename T>
+bool TCountingQueue<T>::try_push(const T&) noexcept
+{
+    if (full())
+        return false;
+    length++;
+    return true;
+}
+
+template<typename T>
+bool TCountingQueue<T>::try_poll(T& element) noexcept
+{
+    if (empty())
+        return false;
+    length--;
+    element = T();
+    return true;
+}
+
+template<typename T>
+size_t TCountingQueue<T>::size() const noexcept
+{
+    return length;
+}
+
+template<typename T>
+size_t TCountingQueue<T>::max_size() const noexcept
+{
+    return capacity;
+}
+
+template<typename T>
+void TCountingQueue<T>::require_not_empty() const
+{
+    if (empty())
+        throw std::logic_error("Queue is empty");
+}
+
+#endif // __COUNTING_QUEUE_H__
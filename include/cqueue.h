@@ -3,23 +3,58 @@
 
 #include "queue.h"
 #include "arraylist.h"
-
-template<typename T>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+// With PowerOfTwo the storage is rounded up to a power of two and the indices
+// run freely, so wrapping them is a mask instead of a division. The queue still
+// holds no more than the requested capacity.
+template<typename T, bool PowerOfTwo = false>
 class TCircularQueue : public TStack<T, TArrayList>
 {
     using TStack<T, TArrayList>::list;
 private:
     const size_t capacity;
+    // Storage size, equal to capacity unless PowerOfTwo
+    const size_t slots;
     size_t length;
     size_t idxBegin, idxEnd;
 
-    size_t translate_index(size_t idx) noexcept;
-    void update_constraints() noexcept;
+    static size_t storage_size(size_t capacity);
+
+    // The list only provides storage, slots are constructed and destroyed here
+    size_t position(size_t idx) const noexcept;
+    T* slot(size_t idx) const noexcept;
+    size_t offset(size_t idx, size_t count) const noexcept;
+    void destroy_elements() noexcept;
+
+    size_t last_index() const noexcept;
+    void advance(size_t& idx, size_t count) const noexcept;
 
     void require_not_empty() const;
 public:
+    // Contiguous run of queued elements
+    struct TSpan {
+        const T* data;
+        size_t size;
+
+        const T* begin() const noexcept { return data; }
+        const T* end() const noexcept { return data + size; }
+    };
+
     explicit TCircularQueue(size_t capacity);
 
+    TCircularQueue(const TCircularQueue& src);
+    TCircularQueue(TCircularQueue&& src);
+
+    ~TCircularQueue();
+
     bool full() const noexcept;
     bool empty() const noexcept;
 
@@ -29,6 +64,8 @@ public:
     void push(const T& element);
     void push(T&& element);
 
+    template<typename... Args>
+    T& emplace(Args&&... args);
 
     void pop();
     [[nodiscard]]
@@ -39,157 +76,403 @@ public:
     T poll();
     T& peek();
 
+    // False instead of std::overflow_error on a full queue or std::logic_error on an empty one
+    bool try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value);
+    bool try_push(T&& element) noexcept(std::is_nothrow_move_constructible<T>::value);
+    bool try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value);
+    // Takes the last element like pop_element(), false on an empty queue
+    bool try_pop(T& element) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+    // Bulk forms: every call copies at most two contiguous runs (memcpy for
+    // trivially copyable T) and returns how many elements it handled, which
+    // is less than asked when the queue fills up or runs empty
+    size_t push_n(const T* first, size_t count);
+    size_t poll_n(T* out, size_t max);
+    size_t shift_n(size_t max) noexcept;
+
+    // Queued elements in order, as the part up to the end of the buffer and the wrapped part
+    std::array<TSpan, 2> spans() const noexcept;
+
     size_t size() const noexcept;
     size_t max_size() const noexcept;
 };
 
 //
 
-template<typename T>
-TCircularQueue<T>::TCircularQueue(size_t capacity)
-        : TStack<T, TArrayList>(capacity)
+template<typename T, bool PowerOfTwo>
+TCircularQueue<T, PowerOfTwo>::TCircularQueue(size_t capacity)
+        : TStack<T, TArrayList>(storage_size(capacity))
         , capacity(capacity)
+        , slots(storage_size(capacity))
+        , length(0)
+        , idxBegin(0)
+        , idxEnd(0)
+{}
+
+template<typename T, bool PowerOfTwo>
+TCircularQueue<T, PowerOfTwo>::TCircularQueue(const TCircularQueue& src)
+        : TStack<T, TArrayList>(src.slots)
+        , capacity(src.capacity)
+        , slots(src.slots)
         , length(0)
         , idxBegin(0)
         , idxEnd(0)
 {
-    list.reserve(capacity);
+    try
+    {
+        for (; length < src.length; length++)
+            new (slot(length)) T(*src.slot(src.offset(src.idxBegin, length)));
+    }
+    catch (...)
+    {
+        destroy_elements();
+        throw;
+    }
+    idxEnd = offset(0, length);
+}
+
+template<typename T, bool PowerOfTwo>
+TCircularQueue<T, PowerOfTwo>::TCircularQueue(TCircularQueue&& src)
+        : TStack<T, TArrayList>(src.slots)
+        , capacity(src.capacity)
+        , slots(src.slots)
+        , length(0)
+        , idxBegin(0)
+        , idxEnd(0)
+{
+    // The source keeps the fresh buffer, so it stays usable
+    swap(list, src.list);
+    std::swap(length, src.length);
+    std::swap(idxBegin, src.idxBegin);
+    std::swap(idxEnd, src.idxEnd);
+}
+
+template<typename T, bool PowerOfTwo>
+TCircularQueue<T, PowerOfTwo>::~TCircularQueue()
+{
+    destroy_elements();
 }
 
-template<typename T>
-size_t TCircularQueue<T>::translate_index(size_t idx) noexcept
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::storage_size(size_t capacity)
 {
-    idx += idxBegin;
-    if (idx > length) {
-        idx -= length;
+    if (!PowerOfTwo || capacity == 0)
+        return capacity;
+
+    if (capacity > (std::numeric_limits<size_t>::max() >> 1) + 1)
+    {
+        throw std::length_error("Queue capacity is too large");
+    }
+
+    size_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+    return size;
+}
+
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::position(size_t idx) const noexcept
+{
+    if constexpr (PowerOfTwo)
+        return idx & (slots - 1);
+    else
+        return idx;
+}
+
+template<typename T, bool PowerOfTwo>
+T* TCircularQueue<T, PowerOfTwo>::slot(size_t idx) const noexcept
+{
+    return list.begin() + position(idx);
+}
+
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::offset(size_t idx, size_t count) const noexcept
+{
+    if constexpr (PowerOfTwo)
+        return idx + count;
+    else
+        return (idx + count) % capacity;
+}
+
+template<typename T, bool PowerOfTwo>
+void TCircularQueue<T, PowerOfTwo>::destroy_elements() noexcept
+{
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        for (size_t i = 0; i < length; i++)
+            slot(offset(idxBegin, i))->~T();
     }
-    return idx;
 }
 
-template<typename T>
-void TCircularQueue<T>::update_constraints() noexcept
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::last_index() const noexcept
 {
-    idxBegin %= capacity;
-    idxEnd %= capacity;
+    if constexpr (PowerOfTwo)
+        return idxEnd - 1;
+    else
+        return idxEnd > 0 ? idxEnd - 1 : capacity - 1;
 }
 
-template<typename T>
-bool TCircularQueue<T>::full() const noexcept
+template<typename T, bool PowerOfTwo>
+void TCircularQueue<T, PowerOfTwo>::advance(size_t& idx, size_t count) const noexcept
+{
+    idx += count;
+    if constexpr (!PowerOfTwo)
+    {
+        if (idx >= capacity)
+            idx -= capacity;
+    }
+}
+
+template<typename T, bool PowerOfTwo>
+bool TCircularQueue<T, PowerOfTwo>::full() const noexcept
 {
     return length == capacity;
 }
 
-template<typename T>
-bool TCircularQueue<T>::empty() const noexcept
+template<typename T, bool PowerOfTwo>
+bool TCircularQueue<T, PowerOfTwo>::empty() const noexcept
 {
     return length == 0;
 }
 
-template<typename T>
-T& TCircularQueue<T>::top()
+template<typename T, bool PowerOfTwo>
+T& TCircularQueue<T, PowerOfTwo>::top()
 {
     this->require_not_empty();
-    return list[idxEnd];
+    return *slot(last_index());
 }
 
-template<typename T>
-T& TCircularQueue<T>::bottom()
+template<typename T, bool PowerOfTwo>
+T& TCircularQueue<T, PowerOfTwo>::bottom()
 {
     this->require_not_empty();
-    return list[idxBegin];
+    return *slot(idxBegin);
+}
+
+template<typename T, bool PowerOfTwo>
+void TCircularQueue<T, PowerOfTwo>::push(const T& element)
+{
+    emplace(element);
 }
 
-template<typename T>
-void TCircularQueue<T>::push(const T& element)
+template<typename T, bool PowerOfTwo>
+void TCircularQueue<T, PowerOfTwo>::push(T&& element)
+{
+    emplace(std::move(element));
+}
+
+template<typename T, bool PowerOfTwo>
+template<typename... Args>
+T& TCircularQueue<T, PowerOfTwo>::emplace(Args&&... args)
 {
     if (full())
     {
         throw std::overflow_error("Queue is full");
     }
 
-    list[idxEnd] = element;
-    idxEnd++;
+    T& element = *new (slot(idxEnd)) T(std::forward<Args>(args)...);
+    advance(idxEnd, 1);
     length++;
-
-    update_constraints();
+    return element;
 }
 
-template<typename T>
-void TCircularQueue<T>::push(T&& element)
+template<typename T, bool PowerOfTwo>
+void TCircularQueue<T, PowerOfTwo>::shift()
 {
-    push(element);
+    this->require_not_empty();
+
+    slot(idxBegin)->~T();
+    advance(idxBegin, 1);
+    length--;
 }
 
-template<typename T>
-void TCircularQueue<T>::shift()
+template<typename T, bool PowerOfTwo>
+T TCircularQueue<T, PowerOfTwo>::poll()
 {
     this->require_not_empty();
 
-    idxBegin++;
+    T element = std::move(*slot(idxBegin));
+    slot(idxBegin)->~T();
+
+    advance(idxBegin, 1);
     length--;
 
-    update_constraints();
+    return element;
 }
 
-template<typename T>
-T TCircularQueue<T>::poll()
+template<typename T, bool PowerOfTwo>
+bool TCircularQueue<T, PowerOfTwo>::try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value)
 {
-    this->require_not_empty();
+    if (full())
+        return false;
+
+    new (slot(idxEnd)) T(element);
+    advance(idxEnd, 1);
+    length++;
+    return true;
+}
 
-    T element = list[idxBegin];
+template<typename T, bool PowerOfTwo>
+bool TCircularQueue<T, PowerOfTwo>::try_push(T&& element) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    if (full())
+        return false;
 
-    idxBegin++;
+    new (slot(idxEnd)) T(std::move(element));
+    advance(idxEnd, 1);
+    length++;
+    return true;
+}
+
+template<typename T, bool PowerOfTwo>
+bool TCircularQueue<T, PowerOfTwo>::try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+    if (empty())
+        return false;
+
+    element = std::move(*slot(idxBegin));
+    slot(idxBegin)->~T();
+    advance(idxBegin, 1);
     length--;
-    update_constraints();
+    return true;
+}
 
-    return element;
+template<typename T, bool PowerOfTwo>
+bool TCircularQueue<T, PowerOfTwo>::try_pop(T& element) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+    if (empty())
+        return false;
+
+    idxEnd = last_index();
+    length--;
+
+    element = std::move(*slot(idxEnd));
+    slot(idxEnd)->~T();
+    return true;
+}
+
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::push_n(const T* first, size_t count)
+{
+    const size_t total = std::min(count, capacity - length);
+
+    size_t done = 0;
+    while (done < total)
+    {
+        const size_t run = std::min(total - done, slots - position(idxEnd));
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            std::memcpy(static_cast<void*>(slot(idxEnd)), first + done, run * sizeof(T));
+        }
+        else
+        {
+            std::uninitialized_copy(first + done, first + done + run, slot(idxEnd));
+        }
+
+        advance(idxEnd, run);
+        length += run;
+        done += run;
+    }
+    return total;
+}
+
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::poll_n(T* out, size_t max)
+{
+    const size_t total = std::min(max, length);
+
+    size_t done = 0;
+    while (done < total)
+    {
+        const size_t run = std::min(total - done, slots - position(idxBegin));
+        T* const source = slot(idxBegin);
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            std::memcpy(static_cast<void*>(out + done), source, run * sizeof(T));
+        }
+        else
+        {
+            std::move(source, source + run, out + done);
+            std::destroy(source, source + run);
+        }
+
+        advance(idxBegin, run);
+        length -= run;
+        done += run;
+    }
+    return total;
 }
 
-template<typename T>
-T& TCircularQueue<T>::peek()
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::shift_n(size_t max) noexcept
+{
+    const size_t total = std::min(max, length);
+
+    size_t done = 0;
+    while (done < total)
+    {
+        const size_t run = std::min(total - done, slots - position(idxBegin));
+        std::destroy(slot(idxBegin), slot(idxBegin) + run);
+
+        advance(idxBegin, run);
+        length -= run;
+        done += run;
+    }
+    return total;
+}
+
+template<typename T, bool PowerOfTwo>
+std::array<typename TCircularQueue<T, PowerOfTwo>::TSpan, 2> TCircularQueue<T, PowerOfTwo>::spans() const noexcept
+{
+    const size_t head = std::min(length, slots - position(idxBegin));
+    return {{ { slot(idxBegin), head }, { list.begin(), length - head } }};
+}
+
+template<typename T, bool PowerOfTwo>
+T& TCircularQueue<T, PowerOfTwo>::peek()
 {
     this->require_not_empty();
-    return list[idxBegin];
+    return *slot(idxBegin);
 }
 
-template<typename T>
-void TCircularQueue<T>::pop()
+template<typename T, bool PowerOfTwo>
+void TCircularQueue<T, PowerOfTwo>::pop()
 {
     this->require_not_empty();
 
-    idxEnd--;
+    idxEnd = last_index();
     length--;
-    update_constraints();
+    slot(idxEnd)->~T();
 }
 
-template<typename T>
-T TCircularQueue<T>::pop_element()
+template<typename T, bool PowerOfTwo>
+T TCircularQueue<T, PowerOfTwo>::pop_element()
 {
     this->require_not_empty();
 
-    T element = list[idxEnd];
-
-    idxEnd--;
+    idxEnd = last_index();
     length--;
-    update_constraints();
 
+    T element = std::move(*slot(idxEnd));
+    slot(idxEnd)->~T();
     return element;
 }
 
-template<typename T>
-size_t TCircularQueue<T>::size() const noexcept
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::size() const noexcept
 {
     return length;
 }
 
-template<typename T>
-size_t TCircularQueue<T>::max_size() const noexcept
+template<typename T, bool PowerOfTwo>
+size_t TCircularQueue<T, PowerOfTwo>::max_size() const noexcept
 {
     return capacity;
 }
 
-template<typename T>
-void TCircularQueue<T>::require_not_empty() const
+template<typename T, bool PowerOfTwo>
+void TCircularQueue<T, PowerOfTwo>::require_not_empty() const
 {
     if (empty())
         throw std::logic_error("Queue is empty");
@@ -0,0 +1,140 @@
+#ifndef __DYNAMIC_CIRCULAR_QUEUE_H__
+#define __DYNAMIC_CIRCULAR_QUEUE_H__
+
+#include "queue.h"
+#include "ringlist.h"
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Circular queue that grows instead of filling up. When the ring is out of
+// slots it moves to one twice as large, copying the wrapped-around part after
+// the rest so the elements stay in order. It shrinks back by half once the
+// occupancy stayed under a quarter for as many removals as it has slots, so
+// a single burst does not pin the memory for good. The queue is full only at
+// its soft bound max_size().
+template<typename T>
+class TDynamicCircularQueue : public TBaseQueue<T, TRingList>
+{
+    using TBaseQueue<T, TRingList>::list;
+public:
+    static constexpr size_t Unbounded = std::numeric_limits<size_t>::max();
+private:
+    const size_t initial;
+    // Removals in a row that left the ring less than a quarter full
+    size_t idleRemovals;
+
+    void after_removal() noexcept;
+public:
+    explicit TDynamicCircularQueue(size_t initial_capacity = 8, size_t capacity = Unbounded);
+
+    // The removals of TBaseQueue and TStack followed by the shrink check
+    void shift();
+    [[nodiscard]]
+    T poll();
+    bool try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+    void pop();
+    [[nodiscard]]
+    T pop_element();
+    bool try_pop(T& element) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+    // Slots allocated right now
+    size_t reserved() const noexcept;
+};
+
+//
+
+template<typename T>
+TDynamicCircularQueue<T>::TDynamicCircularQueue(size_t initial_capacity, size_t capacity)
+        : TBaseQueue<T, TRingList>(capacity, std::min(initial_capacity, capacity))
+        , initial(list.reserved())
+        , idleRemovals(0)
+{}
+
+template<typename T>
+void TDynamicCircularQueue<T>::after_removal() noexcept
+{
+    const size_t slots = list.reserved();
+    if (slots <= initial || list.size() >= slots / 4)
+    {
+        idleRemovals = 0;
+        return;
+    }
+
+    if (++idleRemovals < slots)
+        return;
+    idleRemovals = 0;
+
+    // Relocating moves the elements, which must not fail halfway through a removal
+    if constexpr (std::is_nothrow_move_constructible<T>::value)
+    {
+        try
+        {
+            list.shrink(std::max(slots / 2, initial));
+        }
+        catch (const std::bad_alloc&)
+        {
+            // Keeping the larger ring is fine
+        }
+    }
+}
+
+template<typename T>
+void TDynamicCircularQueue<T>::shift()
+{
+    TBaseQueue<T, TRingList>::shift();
+    after_removal();
+}
+
+template<typename T>
+T TDynamicCircularQueue<T>::poll()
+{
+    T element = TBaseQueue<T, TRingList>::poll();
+    after_removal();
+    return element;
+}
+
+template<typename T>
+bool TDynamicCircularQueue<T>::try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+    if (!TBaseQueue<T, TRingList>::try_poll(element))
+        return false;
+
+    after_removal();
+    return true;
+}
+
+template<typename T>
+void TDynamicCircularQueue<T>::pop()
+{
+    TBaseQueue<T, TRingList>::pop();
+    after_removal();
+}
+
+template<typename T>
+T TDynamicCircularQueue<T>::pop_element()
+{
+    T element = TBaseQueue<T, TRingList>::pop_element();
+    after_removal();
+    return element;
+}
+
+template<typename T>
+bool TDynamicCircularQueue<T>::try_pop(T& element) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+    if (!TBaseQueue<T, TRingList>::try_pop(element))
+        return false;
+
+    after_removal();
+    return true;
+}
+
+template<typename T>
+size_t TDynamicCircularQueue<T>::reserved() const noexcept
+{
+    return list.reserved();
+}
+
+#endif // __DYNAMIC_CIRCULAR_QUEUE_H__
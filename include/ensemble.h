@@ -0,0 +1,344 @@
+#ifndef __ENSEMBLE_H__
+#define __ENSEMBLE_H__
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "cluster.h"
+#include "random.h"
+
+// Set of 64 * Words one-bit lanes. Operations are plain loops over the words,
+// so with Words = 4 the compiler maps them onto 256-bit vector registers.
+template<size_t Words>
+struct TBitLanes {
+    uint64_t word[Words];
+
+    static TBitLanes filled(bool value) noexcept
+    {
+        TBitLanes lanes;
+        for (size_t w = 0; w < Words; w++)
+            lanes.word[w] = value ? ~uint64_t(0) : 0;
+        return lanes;
+    }
+
+    bool test(size_t lane) const noexcept
+    {
+        return (word[lane / 64] >> (lane % 64)) & 1;
+    }
+
+    bool none() const noexcept
+    {
+        uint64_t any = 0;
+        for (size_t w = 0; w < Words; w++)
+            any |= word[w];
+        return any == 0;
+    }
+
+    TBitLanes operator~() const noexcept
+    {
+        TBitLanes lanes;
+        for (size_t w = 0; w < Words; w++)
+            lanes.word[w] = ~word[w];
+        return lanes;
+    }
+
+    TBitLanes operator&(const TBitLanes& other) const noexcept
+    {
+        TBitLanes lanes;
+        for (size_t w = 0; w < Words; w++)
+            lanes.word[w] = word[w] & other.word[w];
+        return lanes;
+    }
+
+    TBitLanes operator|(const TBitLanes& other) const noexcept
+    {
+        TBitLanes lanes;
+        for (size_t w = 0; w < Words; w++)
+            lanes.word[w] = word[w] | other.word[w];
+        return lanes;
+    }
+
+    TBitLanes operator^(const TBitLanes& other) const noexcept
+    {
+        TBitLanes lanes;
+        for (size_t w = 0; w < Words; w++)
+            lanes.word[w] = word[w] ^ other.word[w];
+        return lanes;
+    }
+};
+
+// Runs 64 * Words independent TCluster models in lockstep, cycle by cycle.
+// Every lane keeps its queue length as a column of bits across bit planes,
+// and both Bernoulli trials of a cycle are drawn for all lanes at once.
+template<size_t Words = 1>
+class TEnsembleCluster {
+public:
+    static constexpr size_t Lanes = 64 * Words;
+private:
+    typedef TBitLanes<Words> Lanes_t;
+
+    // Bits of probability resolution for the lane-parallel Bernoulli draws
+    static constexpr int Precision = 32;
+    // Per-lane event counters are bit-sliced too and flushed before they can overflow
+    static constexpr int CounterPlanes = 16;
+
+    struct TSlicedCounter {
+        Lanes_t plane[CounterPlanes];
+        long long flushed[Lanes];
+
+        TSlicedCounter();
+        void add(Lanes_t mask) noexcept;
+        void flush() noexcept;
+    };
+
+    const size_t capacity;
+    const uint64_t arrivalFraction;
+    const uint64_t completionFraction;
+
+    TXoshiro256 engine;
+
+    std::vector<Lanes_t> queue;
+    Lanes_t busy;
+
+    TSlicedCounter total, rejected, completed, idle;
+    long long cycles;
+    long long pending;
+
+    static uint64_t fraction(double probability) noexcept;
+
+    Lanes_t random_lanes() noexcept;
+    Lanes_t bernoulli(uint64_t fraction) noexcept;
+
+    Lanes_t queue_is_full() const noexcept;
+    Lanes_t queue_is_empty() const noexcept;
+    void increment_queue(Lanes_t mask) noexcept;
+    void decrement_queue(Lanes_t mask) noexcept;
+
+    void flush_counters() noexcept;
+public:
+    TEnsembleCluster(size_t capacity, double intensity, double performance, uint64_t seed);
+
+    void simulate(long long cycles);
+
+    [[nodiscard]]
+    TPerfStat stats(size_t lane) const;
+    [[nodiscard]]
+    std::vector<TPerfStat> stats() const;
+};
+
+//
+
+template<size_t Words>
+TEnsembleCluster<Words>::TSlicedCounter::TSlicedCounter()
+{
+    for (auto& bits : plane)
+        bits = Lanes_t::filled(false);
+    for (auto& value : flushed)
+        value = 0;
+}
+
+template<size_t Words>
+void TEnsembleCluster<Words>::TSlicedCounter::add(Lanes_t mask) noexcept
+{
+    // Ripple-carry increment of the lanes set in mask
+    for (int i = 0; i < CounterPlanes && !mask.none(); i++)
+    {
+        const Lanes_t carry = plane[i] & mask;
+        plane[i] = plane[i] ^ mask;
+        mask = carry;
+    }
+}
+
+template<size_t Words>
+void TEnsembleCluster<Words>::TSlicedCounter::flush() noexcept
+{
+    for (size_t lane = 0; lane < Lanes; lane++)
+    {
+        long long value = 0;
+        for (int i = 0; i < CounterPlanes; i++)
+            value |= static_cast<long long>(plane[i].test(lane)) << i;
+        flushed[lane] += value;
+    }
+    for (auto& bits : plane)
+        bits = Lanes_t::filled(false);
+}
+
+template<size_t Words>
+TEnsembleCluster<Words>::TEnsembleCluster(size_t capacity, double intensity, double performance, uint64_t seed)
+        : capacity(capacity > 0
+                   ? capacity
+                   : throw std::invalid_argument("Cluster capacity should be greater than 0"))
+        , arrivalFraction(fraction(intensity))
+        , completionFraction(fraction(performance))
+        , engine(seed)
+        , busy(Lanes_t::filled(false))
+        , cycles(0)
+        , pending(0)
+{
+    size_t bits = 0;
+    for (size_t value = capacity; value; value >>= 1)
+        bits++;
+    queue.assign(bits, Lanes_t::filled(false));
+}
+
+template<size_t Words>
+uint64_t TEnsembleCluster<Words>::fraction(double probability) noexcept
+{
+    if (probability <= 0.0)
+        return 0;
+    if (probability >= 1.0)
+        return uint64_t(1) << Precision;
+    return static_cast<uint64_t>(probability * static_cast<double>(uint64_t(1) << Precision));
+}
+
+template<size_t Words>
+typename TEnsembleCluster<Words>::Lanes_t TEnsembleCluster<Words>::random_lanes() noexcept
+{
+    Lanes_t lanes;
+    for (size_t w = 0; w < Words; w++)
+        lanes.word[w] = engine();
+    return lanes;
+}
+
+template<size_t Words>
+typename TEnsembleCluster<Words>::Lanes_t TEnsembleCluster<Words>::bernoulli(uint64_t fraction) noexcept
+{
+    if (fraction >> Precision)
+        return Lanes_t::filled(true);
+
+    // Compares a uniform Precision-bit number in every lane with the binary
+    // expansion of p, from the least significant bit up: a one bit gives
+    // (1 + P) / 2, a zero bit P / 2. Trailing zero bits cost no draws.
+    Lanes_t result = Lanes_t::filled(false);
+    for (int i = 0; i < Precision; i++, fraction >>= 1)
+    {
+        if (fraction & 1)
+            result = result | random_lanes();
+        else if (!result.none())
+            result = result & random_lanes();
+    }
+    return result;
+}
+
+template<size_t Words>
+typename TEnsembleCluster<Words>::Lanes_t TEnsembleCluster<Words>::queue_is_full() const noexcept
+{
+    Lanes_t equal = Lanes_t::filled(true);
+    for (size_t i = 0; i < queue.size(); i++)
+        equal = equal & (((capacity >> i) & 1) ? queue[i] : ~queue[i]);
+    return equal;
+}
+
+template<size_t Words>
+typename TEnsembleCluster<Words>::Lanes_t TEnsembleCluster<Words>::queue_is_empty() const noexcept
+{
+    Lanes_t any = Lanes_t::filled(false);
+    for (const Lanes_t& bits : queue)
+        any = any | bits;
+    return ~any;
+}
+
+template<size_t Words>
+void TEnsembleCluster<Words>::increment_queue(Lanes_t mask) noexcept
+{
+    for (size_t i = 0; i < queue.size() && !mask.none(); i++)
+    {
+        const Lanes_t carry = queue[i] & mask;
+        queue[i] = queue[i] ^ mask;
+        mask = carry;
+    }
+}
+
+template<size_t Words>
+void TEnsembleCluster<Words>::decrement_queue(Lanes_t mask) noexcept
+{
+    for (size_t i = 0; i < queue.size() && !mask.none(); i++)
+    {
+        const Lanes_t borrow = ~queue[i] & mask;
+        queue[i] = queue[i] ^ mask;
+        mask = borrow;
+    }
+}
+
+template<size_t Words>
+void TEnsembleCluster<Words>::flush_counters() noexcept
+{
+    total.flush();
+    rejected.flush();
+    completed.flush();
+    idle.flush();
+    pending = 0;
+}
+
+template<size_t Words>
+void TEnsembleCluster<Words>::simulate(long long count)
+{
+    const long long flushEvery = (1LL << CounterPlanes) - 1;
+
+    for (long long tick = 0; tick < count; tick++)
+    {
+        // generate_tasks()
+        const Lanes_t arrived = bernoulli(arrivalFraction);
+        const Lanes_t full = queue_is_full();
+        total.add(arrived);
+        rejected.add(arrived & full);
+        increment_queue(arrived & ~full);
+
+        // perform_cycle()
+        const Lanes_t empty = queue_is_empty();
+        idle.add(~busy & empty);
+
+        const Lanes_t started = ~busy & ~empty;
+        decrement_queue(started);
+        busy = busy | started;
+
+        const Lanes_t done = busy & bernoulli(completionFraction);
+        completed.add(done);
+        busy = busy & ~done;
+
+        if (++pending == flushEvery)
+            flush_counters();
+    }
+
+    cycles += count;
+}
+
+template<size_t Words>
+TPerfStat TEnsembleCluster<Words>::stats(size_t lane) const
+{
+    if (lane >= Lanes)
+        throw std::out_of_range("Lane is out of range");
+
+    // Counters still in bit planes are summed on a copy, so reading does not disturb a run
+    TEnsembleCluster copy(*this);
+    copy.flush_counters();
+
+    TPerfStat stat;
+    stat.total_tasks = copy.total.flushed[lane];
+    stat.rejected_tasks = copy.rejected.flushed[lane];
+    stat.completed_tasks = copy.completed.flushed[lane];
+    stat.idle_cycles = copy.idle.flushed[lane];
+    stat.cycles = cycles;
+    return stat;
+}
+
+template<size_t Words>
+std::vector<TPerfStat> TEnsembleCluster<Words>::stats() const
+{
+    TEnsembleCluster copy(*this);
+    copy.flush_counters();
+
+    std::vector<TPerfStat> result(Lanes);
+    for (size_t lane = 0; lane < Lanes; lane++)
+    {
+        result[lane].total_tasks = copy.total.flushed[lane];
+        result[lane].rejected_tasks = copy.rejected.flushed[lane];
+        result[lane].completed_tasks = copy.completed.flushed[lane];
+        result[lane].idle_cycles = copy.idle.flushed[lane];
+        result[lane].cycles = cycles;
+    }
+    return result;
+}
+
+#endif // __ENSEMBLE_H__
@@ -0,0 +1,162 @@
+#ifndef __HISTOGRAM_H__
+#define __HISTOGRAM_H__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Log-linear histogram of non-negative integers in the spirit of HdrHistogram.
+// Values below 2^SubBucketBits get a bucket each; above that every power of two
+// is split into 2^(SubBucketBits - 1) equal buckets, so a reported value is
+// within 1 / 2^(SubBucketBits - 1) of the recorded one. All buckets are
+// allocated up front and record() never allocates.
+class TLatencyHistogram {
+public:
+    static constexpr int SubBucketBits = 7;
+private:
+    static constexpr uint64_t SubBuckets = uint64_t(1) << SubBucketBits;
+    static constexpr uint64_t HalfBuckets = SubBuckets / 2;
+    static constexpr size_t Buckets = (66 - SubBucketBits) * HalfBuckets;
+
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t sum;
+    uint64_t minimum;
+    uint64_t maximum;
+
+    static int highest_bit(uint64_t value) noexcept;
+    static size_t bucket(uint64_t value) noexcept;
+    static uint64_t highest_equivalent(size_t bucket) noexcept;
+public:
+    TLatencyHistogram();
+
+    // Negative values are recorded as 0
+    void record(long long value) noexcept;
+
+    long long count() const noexcept;
+    long long min() const noexcept;
+    long long max() const noexcept;
+    double mean() const noexcept;
+
+    // Smallest recorded value v such that a share q of the values is <= v,
+    // up to the bucket precision
+    [[nodiscard]]
+    long long percentile(double q) const noexcept;
+
+    long long p50() const noexcept { return percentile(0.5); }
+    long long p99() const noexcept { return percentile(0.99); }
+    long long p999() const noexcept { return percentile(0.999); }
+
+    TLatencyHistogram& operator+=(const TLatencyHistogram& other) noexcept;
+};
+
+//
+
+inline TLatencyHistogram::TLatencyHistogram()
+        : counts(Buckets, 0)
+        , total(0)
+        , sum(0)
+        , minimum(std::numeric_limits<uint64_t>::max())
+        , maximum(0)
+{}
+
+inline int TLatencyHistogram::highest_bit(uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value | 1);
+#else
+    int bit = 0;
+    for (int step = 32; step > 0; step /= 2)
+    {
+        if (value >> step)
+        {
+            value >>= step;
+            bit += step;
+        }
+    }
+    return bit;
+#endif
+}
+
+inline size_t TLatencyHistogram::bucket(uint64_t value) noexcept
+{
+    if (value < SubBuckets)
+        return static_cast<size_t>(value);
+
+    const int shift = highest_bit(value) - SubBucketBits + 1;
+    return static_cast<size_t>(shift * HalfBuckets + (value >> shift));
+}
+
+inline uint64_t TLatencyHistogram::highest_equivalent(size_t bucket) noexcept
+{
+    if (bucket < SubBuckets)
+        return bucket;
+
+    const int shift = static_cast<int>(bucket / HalfBuckets) - 1;
+    const uint64_t mantissa = bucket % HalfBuckets + HalfBuckets;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+inline void TLatencyHistogram::record(long long value) noexcept
+{
+    const uint64_t sample = value > 0 ? static_cast<uint64_t>(value) : 0;
+
+    counts[bucket(sample)]++;
+    total++;
+    sum += sample;
+    minimum = std::min(minimum, sample);
+    maximum = std::max(maximum, sample);
+}
+
+inline long long TLatencyHistogram::count() const noexcept
+{
+    return static_cast<long long>(total);
+}
+
+inline long long TLatencyHistogram::min() const noexcept
+{
+    return total ? static_cast<long long>(minimum) : 0;
+}
+
+inline long long TLatencyHistogram::max() const noexcept
+{
+    return static_cast<long long>(maximum);
+}
+
+inline double TLatencyHistogram::mean() const noexcept
+{
+    return total ? static_cast<double>(sum) / total : 0.0;
+}
+
+inline long long TLatencyHistogram::percentile(double q) const noexcept
+{
+    if (total == 0)
+        return 0;
+
+    q = std::min(std::max(q, 0.0), 1.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * total)));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < Buckets; i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+            return static_cast<long long>(std::min(std::max(highest_equivalent(i), minimum), maximum));
+    }
+    return static_cast<long long>(maximum);
+}
+
+inline TLatencyHistogram& TLatencyHistogram::operator+=(const TLatencyHistogram& other) noexcept
+{
+    for (size_t i = 0; i < Buckets; i++)
+        counts[i] += other.counts[i];
+    total += other.total;
+    sum += other.sum;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+    return *this;
+}
+
+#endif // __HISTOGRAM_H__
@@ -2,7 +2,10 @@
 #define __LINKEDLIST_H__
 
 #include <stdexcept>
+#include <algorithm>
 #include <cassert>
+#include <utility>
+#include "nodepool.h"
 
 template<class T>
 class TLinkedList {
@@ -10,15 +13,26 @@ private:
     size_t length;
     struct Node {
         T value;
-        Node *next = nullptr;
+        Node *next;
+
+        template<typename... Args>
+        explicit Node(Node *next, Args&&... args)
+                : value(std::forward<Args>(args)...)
+                , next(next)
+        {}
     } *first, *last;
+    TNodePool<Node> pool;
+
+    // Nodes allocated by the constructor at most, a larger list grows on demand
+    static constexpr size_t MaxReserved = 1024;
 
     Node* get_node(size_t idx) const;
     void destroy_nodes();
 public:
     typedef T value_type;
 
-    explicit TLinkedList(size_t = 0);
+    // Nodes for the given number of elements, up to MaxReserved, are allocated up front
+    explicit TLinkedList(size_t reserved = 0);
     TLinkedList(const TLinkedList& src);
     TLinkedList(TLinkedList&& src) noexcept;
 
@@ -32,13 +46,20 @@ public:
     void push_back(const T& element);
     void push_back(T&& element);
 
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+
     void push_front(const T& element);
     void push_front(T&& element);
 
+    template<typename... Args>
+    T& emplace_front(Args&&... args);
+
     void insert(size_t pos, const T& element);
     void insert(size_t pos, T&& element);
 
     void remove(size_t idx);
+    void pop_front();
 
     T& front();
     T& back();
@@ -62,6 +83,7 @@ public:
         std::swap(lhs.length, rhs.length);
         std::swap(lhs.first, rhs.first);
         std::swap(lhs.last, rhs.last);
+        swap(lhs.pool, rhs.pool);
     }
 };
 
@@ -81,20 +103,22 @@ void TLinkedList<T>::destroy_nodes()
     while (current) {
         garbage = current;
         current = garbage->next;
-        delete garbage;
+        pool.destroy(garbage);
     }
 }
 
 template<class T>
-TLinkedList<T>::TLinkedList(size_t)
+TLinkedList<T>::TLinkedList(size_t reserved)
         : length(0)
         , first(nullptr)
         , last(nullptr)
+        , pool(std::min(reserved, MaxReserved))
 {}
 
 template<class T>
 TLinkedList<T>::TLinkedList(const TLinkedList<T>& src)
         : length(src.length)
+        , pool(src.length)
 {
     if (!src.first) {
         first = last = nullptr;
@@ -102,19 +126,20 @@ TLinkedList<T>::TLinkedList(const TLinkedList<T>& src)
     }
 
     Node *current, *c_src = src.first;
-    first = current = new Node { src.first };
+    first = current = pool.create(nullptr, c_src->value);
     while (c_src->next)
     {
-        current->next = new Node { c_src->value };
-        current = current->next;
         c_src = c_src->next;
+        current->next = pool.create(nullptr, c_src->value);
+        current = current->next;
     }
     last = current;
 }
 
 template<class T>
 TLinkedList<T>::TLinkedList(TLinkedList &&src) noexcept
-        : first(nullptr)
+        : length(0)
+        , first(nullptr)
         , last(nullptr)
 {
     swap(*this, src);
@@ -141,7 +166,20 @@ bool TLinkedList<T>::empty() const noexcept
 template<class T>
 void TLinkedList<T>::push_back(const T& element)
 {
-    Node* node = new Node{ element };
+    emplace_back(element);
+}
+
+template<class T>
+void TLinkedList<T>::push_back(T &&element)
+{
+    emplace_back(std::move(element));
+}
+
+template<class T>
+template<typename... Args>
+T& TLinkedList<T>::emplace_back(Args&&... args)
+{
+    Node* node = pool.create(nullptr, std::forward<Args>(args)...);
 
     if (first == nullptr)
     {
@@ -154,25 +192,32 @@ void TLinkedList<T>::push_back(const T& element)
     }
 
     length++;
+    return node->value;
 }
 
 template<class T>
-void TLinkedList<T>::push_back(T &&element)
+void TLinkedList<T>::push_front(const T& element)
 {
-    push_back(element);
+    emplace_front(element);
 }
 
 template<class T>
-void TLinkedList<T>::push_front(const T& element)
+void TLinkedList<T>::push_front(T &&element)
 {
-    first = new Node { element, first };
-    length++;
+    emplace_front(std::move(element));
 }
 
 template<class T>
-void TLinkedList<T>::push_front(T &&element)
+template<typename... Args>
+T& TLinkedList<T>::emplace_front(Args&&... args)
 {
-    push_front(element);
+    first = pool.create(first, std::forward<Args>(args)...);
+    if (last == nullptr)
+    {
+        last = first;
+    }
+    length++;
+    return first->value;
 }
 
 template<class T>
@@ -181,14 +226,26 @@ void TLinkedList<T>::insert(size_t pos, const T& element)
     assert(pos < length && "Index is out of range");
 
     Node *node = get_node(pos);
-    node->next = new Node { element, node->next };
+    node->next = pool.create(node->next, element);
+    if (node == last)
+    {
+        last = node->next;
+    }
     length++;
 }
 
 template<class T>
 void TLinkedList<T>::insert(size_t pos, T &&element)
 {
-    insert(pos, element);
+    assert(pos < length && "Index is out of range");
+
+    Node *node = get_node(pos);
+    node->next = pool.create(node->next, std::move(element));
+    if (node == last)
+    {
+        last = node->next;
+    }
+    length++;
 }
 
 template<class T>
@@ -201,14 +258,38 @@ void TLinkedList<T>::remove(size_t idx)
     {
         node = first;
         first = node->next;
+        if (node == last)
+        {
+            last = nullptr;
+        }
     }
     else
     {
         TLinkedList::Node* prev = get_node(idx - 1);
         node = prev->next;
         prev->next = node->next;
+        if (node == last)
+        {
+            last = prev;
+        }
+    }
+    pool.destroy(node);
+
+    length--;
+}
+
+template<class T>
+void TLinkedList<T>::pop_front()
+{
+    assert(length && "List is empty");
+
+    Node* node = first;
+    first = node->next;
+    if (first == nullptr)
+    {
+        last = nullptr;
     }
-    delete node;
+    pool.destroy(node);
 
     length--;
 }
@@ -0,0 +1,250 @@
+#ifndef __MPMC_QUEUE_H__
+#define __MPMC_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Bounded queue shared by any number of producer and consumer threads.
+// Every slot carries a sequence number telling whose turn it is, so threads
+// only contend on the position counters and never take a lock. Elements
+// are constructed in a slot on push and destroyed when polled, so T needs
+// neither a default constructor nor assignment.
+template<typename T>
+class TMpmcQueue
+{
+private:
+    static constexpr size_t CacheLineSize = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        // Holds an element from the push that fills it to the poll that empties it
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+        T* element() noexcept { return std::launder(reinterpret_cast<T*>(&storage)); }
+    };
+
+    // Destroys the element of a claimed cell and hands the cell to the next lap's producer
+    struct TRelease {
+        Cell* cell;
+        size_t next;
+
+        ~TRelease()
+        {
+            cell->element()->~T();
+            cell->sequence.store(next, std::memory_order_release);
+        }
+    };
+
+    const size_t capacity;
+    Cell *cells;
+
+    template<typename U>
+    bool try_push_element(U&& element);
+    // Claims the oldest filled cell for this consumer, nullptr on an empty queue
+    Cell* claim_element(size_t& pos) noexcept;
+
+    alignas(CacheLineSize) std::atomic<size_t> idxEnd;
+    alignas(CacheLineSize) std::atomic<size_t> idxBegin;
+public:
+    typedef T value_type;
+
+    explicit TMpmcQueue(size_t capacity);
+
+    TMpmcQueue(const TMpmcQueue&) = delete;
+    TMpmcQueue& operator=(const TMpmcQueue&) = delete;
+
+    ~TMpmcQueue();
+
+    // Snapshots, may be outdated as soon as they return
+    bool full() const noexcept;
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    bool try_push(const T& element);
+    bool try_push(T&& element);
+    void push(const T& element);
+    void push(T&& element);
+
+    bool try_poll(T& element);
+    [[nodiscard]]
+    T poll();
+
+    size_t max_size() const noexcept;
+};
+
+//
+
+template<typename T>
+TMpmcQueue<T>::TMpmcQueue(size_t capacity)
+        : capacity(capacity > 0
+                   ? capacity
+                   : throw std::invalid_argument("Queue capacity should be greater than 0"))
+        , cells(new Cell[capacity])
+        , idxEnd(0)
+        , idxBegin(0)
+{
+    for (size_t i = 0; i < capacity; i++)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+TMpmcQueue<T>::~TMpmcQueue()
+{
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        const size_t end = idxEnd.load(std::memory_order_acquire);
+        for (size_t i = idxBegin.load(std::memory_order_acquire); i != end; i++)
+            cells[i % capacity].element()->~T();
+    }
+    delete[] cells;
+}
+
+template<typename T>
+bool TMpmcQueue<T>::full() const noexcept
+{
+    return size() >= capacity;
+}
+
+template<typename T>
+bool TMpmcQueue<T>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+template<typename T>
+size_t TMpmcQueue<T>::size() const noexcept
+{
+    const size_t begin = idxBegin.load(std::memory_order_acquire);
+    const size_t end = idxEnd.load(std::memory_order_acquire);
+    return end > begin ? end - begin : 0;
+}
+
+template<typename T>
+bool TMpmcQueue<T>::try_push(const T& element)
+{
+    return try_push_element(element);
+}
+
+template<typename T>
+bool TMpmcQueue<T>::try_push(T&& element)
+{
+    return try_push_element(std::move(element));
+}
+
+template<typename T>
+template<typename U>
+bool TMpmcQueue<T>::try_push_element(U&& element)
+{
+    size_t pos = idxEnd.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;)
+    {
+        cell = &cells[pos % capacity];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<ptrdiff_t>(sequence - pos);
+
+        if (diff == 0)
+        {
+            if (idxEnd.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // Slot still holds an element from the previous lap
+            return false;
+        }
+        else
+        {
+            pos = idxEnd.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (&cell->storage) T(std::forward<U>(element));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+void TMpmcQueue<T>::push(const T& element)
+{
+    if (!try_push(element))
+    {
+        throw std::overflow_error("Queue is full");
+    }
+}
+
+template<typename T>
+void TMpmcQueue<T>::push(T&& element)
+{
+    if (!try_push(std::move(element)))
+    {
+        throw std::overflow_error("Queue is full");
+    }
+}
+
+template<typename T>
+typename TMpmcQueue<T>::Cell* TMpmcQueue<T>::claim_element(size_t& pos) noexcept
+{
+    pos = idxBegin.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;)
+    {
+        cell = &cells[pos % capacity];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<ptrdiff_t>(sequence - (pos + 1));
+
+        if (diff == 0)
+        {
+            if (idxBegin.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return cell;
+        }
+        else if (diff < 0)
+        {
+            // Slot has not been filled yet
+            return nullptr;
+        }
+        else
+        {
+            pos = idxBegin.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T>
+bool TMpmcQueue<T>::try_poll(T& element)
+{
+    size_t pos;
+    Cell *cell = claim_element(pos);
+    if (!cell)
+        return false;
+
+    TRelease release { cell, pos + capacity };
+    element = std::move(*cell->element());
+    return true;
+}
+
+template<typename T>
+T TMpmcQueue<T>::poll()
+{
+    size_t pos;
+    Cell *cell = claim_element(pos);
+    if (!cell)
+    {
+        throw std::logic_error("Queue is empty");
+    }
+
+    TRelease release { cell, pos + capacity };
+    return std::move(*cell->element());
+}
+
+template<typename T>
+size_t TMpmcQueue<T>::max_size() const noexcept
+{
+    return capacity;
+}
+
+#endif // __MPMC_QUEUE_H__
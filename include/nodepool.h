@@ -0,0 +1,155 @@
+#ifndef __NODEPOOL_H__
+#define __NODEPOOL_H__
+
+#include <cassert>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Free-list allocator handing out storage for objects of a single type.
+// Memory is taken from the heap in slabs and is only returned when the pool
+// is destroyed, so released objects are recycled in place.
+template<class T>
+class TNodePool {
+private:
+    union Slot {
+        Slot *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // Every slab starts with a slot linking it to the previously allocated one
+    Slot *slabs;
+    Slot *vacant;
+    size_t allocated;
+    size_t available;
+
+    void allocate_slab(size_t count);
+public:
+    explicit TNodePool(size_t reserved = 0);
+
+    TNodePool(const TNodePool&) = delete;
+    TNodePool& operator=(const TNodePool&) = delete;
+
+    ~TNodePool();
+
+    template<typename... Args>
+    T* create(Args&&... args);
+    void destroy(T* object) noexcept;
+
+    void reserve(size_t count);
+
+    [[nodiscard]]
+    size_t capacity() const noexcept;
+
+    friend void swap(TNodePool& lhs, TNodePool& rhs) noexcept
+    {
+        std::swap(lhs.slabs, rhs.slabs);
+        std::swap(lhs.vacant, rhs.vacant);
+        std::swap(lhs.allocated, rhs.allocated);
+        std::swap(lhs.available, rhs.available);
+    }
+};
+
+//
+
+template<class T>
+TNodePool<T>::TNodePool(size_t reserved)
+        : slabs(nullptr)
+        , vacant(nullptr)
+        , allocated(0)
+        , available(0)
+{
+    reserve(reserved);
+}
+
+template<class T>
+TNodePool<T>::~TNodePool()
+{
+    while (slabs)
+    {
+        Slot *garbage = slabs;
+        slabs = garbage->next;
+        delete[] garbage;
+    }
+}
+
+template<class T>
+void TNodePool<T>::allocate_slab(size_t count)
+{
+    // One more slot links the slab
+    if (count >= std::numeric_limits<size_t>::max() / sizeof(Slot))
+    {
+        throw std::length_error("Pool slab is too large");
+    }
+
+    Slot *slab = new Slot[count + 1];
+    slab->next = slabs;
+    slabs = slab;
+
+    for (size_t i = count; i > 0; i--)
+    {
+        slab[i].next = vacant;
+        vacant = &slab[i];
+    }
+
+    allocated += count;
+    available += count;
+}
+
+template<class T>
+template<typename... Args>
+T* TNodePool<T>::create(Args&&... args)
+{
+    if (!vacant)
+    {
+        allocate_slab(allocated > 8 ? allocated : 8);
+    }
+
+    // Unlink first, the object is constructed over the link
+    Slot *slot = vacant;
+    vacant = slot->next;
+    available--;
+
+    try
+    {
+        return new (slot->storage) T { std::forward<Args>(args)... };
+    }
+    catch (...)
+    {
+        slot->next = vacant;
+        vacant = slot;
+        available++;
+        throw;
+    }
+}
+
+template<class T>
+void TNodePool<T>::destroy(T* object) noexcept
+{
+    assert(object && "Object is null");
+
+    object->~T();
+
+    Slot *slot = reinterpret_cast<Slot*>(object);
+    slot->next = vacant;
+    vacant = slot;
+    available++;
+}
+
+template<class T>
+void TNodePool<T>::reserve(size_t count)
+{
+    if (count > available)
+    {
+        allocate_slab(count - available);
+    }
+}
+
+template<class T>
+size_t TNodePool<T>::capacity() const noexcept
+{
+    return allocated;
+}
+
+#endif // __NODEPOOL_H__
@@ -7,24 +7,37 @@
 template<typename T, template<typename> class TContainer>
 class TBaseQueue : public TStack<T, TContainer>
 {
+protected:
     using TStack<T, TContainer>::list;
 private:
     const size_t capacity;
+protected:
+    // The list starts with initial_capacity slots instead of capacity
+    TBaseQueue(size_t capacity, size_t initial_capacity);
 public:
     explicit TBaseQueue(size_t capacity);
 
     bool full() const noexcept;
 
-    T& bottom() noexcept;
+    T& bottom();
 
     void push(const T& element);
     void push(T&& element);
 
+    template<typename... Args>
+    T& emplace(Args&&... args);
+
     void shift();
     [[nodiscard]]
     T poll();
     T& peek();
 
+    // False instead of std::overflow_error on a full queue or std::logic_error on an empty one
+    bool try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value
+                                           && TStack<T, TContainer>::NothrowRelocate);
+    bool try_push(T&& element) noexcept(TStack<T, TContainer>::NothrowRelocate);
+    bool try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value);
+
     size_t max_size() const noexcept;
 };
 
@@ -35,7 +48,12 @@ using TQueue = TBaseQueue<T, TLinkedList>;
 
 template<typename T, template<typename> class TContainer>
 TBaseQueue<T, TContainer>::TBaseQueue(size_t capacity)
-        : TStack<T, TContainer>(capacity)
+        : TBaseQueue(capacity, capacity)
+{}
+
+template<typename T, template<typename> class TContainer>
+TBaseQueue<T, TContainer>::TBaseQueue(size_t capacity, size_t initial_capacity)
+        : TStack<T, TContainer>(initial_capacity)
         , capacity(capacity)
 {}
 
@@ -46,7 +64,7 @@ bool TBaseQueue<T, TContainer>::full() const noexcept
 }
 
 template<typename T, template<typename> class TContainer>
-T& TBaseQueue<T, TContainer>::bottom() noexcept
+T& TBaseQueue<T, TContainer>::bottom()
 {
     this->require_not_empty();
     return list.front();
@@ -65,22 +83,37 @@ void TBaseQueue<T, TContainer>::push(const T &element)
 template<typename T, template<typename> class TContainer>
 void TBaseQueue<T, TContainer>::push(T&& element)
 {
-    push(element);
+    if (full())
+    {
+        throw std::overflow_error("Queue is full");
+    }
+    list.push_back(std::move(element));
+}
+
+template<typename T, template<typename> class TContainer>
+template<typename... Args>
+T& TBaseQueue<T, TContainer>::emplace(Args&&... args)
+{
+    if (full())
+    {
+        throw std::overflow_error("Queue is full");
+    }
+    return list.emplace_back(std::forward<Args>(args)...);
 }
 
 template<typename T, template<typename> class TContainer>
 void TBaseQueue<T, TContainer>::shift()
 {
     this->require_not_empty();
-    list.remove(0);
+    list.pop_front();
 }
 
 template<typename T, template<typename> class TContainer>
 T TBaseQueue<T, TContainer>::poll()
 {
     this->require_not_empty();
-    T element = list[0];
-    list.remove(0);
+    T element = std::move(list.front());
+    list.pop_front();
     return element;
 }
 
@@ -88,7 +121,31 @@ template<typename T, template<typename> class TContainer>
 T& TBaseQueue<T, TContainer>::peek()
 {
     this->require_not_empty();
-    return list[0];
+    return list.front();
+}
+
+template<typename T, template<typename> class TContainer>
+bool TBaseQueue<T, TContainer>::try_push(const T& element)
+        noexcept(std::is_nothrow_copy_constructible<T>::value && TStack<T, TContainer>::NothrowRelocate)
+{
+    return !full() && TStack<T, TContainer>::try_push(element);
+}
+
+template<typename T, template<typename> class TContainer>
+bool TBaseQueue<T, TContainer>::try_push(T&& element) noexcept(TStack<T, TContainer>::NothrowRelocate)
+{
+    return !full() && TStack<T, TContainer>::try_push(std::move(element));
+}
+
+template<typename T, template<typename> class TContainer>
+bool TBaseQueue<T, TContainer>::try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+    if (list.empty())
+        return false;
+
+    element = std::move(list.front());
+    list.pop_front();
+    return true;
 }
 
 template<typename T, template<typename> class TContainer>
@@ -1,31 +1,182 @@
 #ifndef __RANDOM_H__
 #define __RANDOM_H__
 
+#include <cstdint>
+#include <limits>
 #include <random>
+#include <type_traits>
 
-template<typename T>
+// xoshiro256** by Blackman and Vigna: 32 bytes of state, period 2^256 - 1
+class TXoshiro256 {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) noexcept;
+public:
+    typedef uint64_t result_type;
+
+    explicit TXoshiro256(uint64_t seed = 0);
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() noexcept;
+
+    // Advances the generator by 2^128 draws, so every jump starts a non-overlapping stream
+    void jump() noexcept;
+};
+
+template<typename T, class TEngine = TXoshiro256>
 class TRandom {
 private:
-    std::random_device rd;
-    std::mt19937 mt;
+    TEngine engine;
     std::uniform_real_distribution<T> dist;
+
+    static uint64_t entropy();
+    static TEngine make_engine(uint64_t seed);
 public:
+    typedef TEngine engine_type;
+    typedef typename TEngine::result_type threshold_type;
+
+    // Seeded from std::random_device
     TRandom(T begin, T end);
+    TRandom(T begin, T end, uint64_t seed);
 
     [[nodiscard]]
     T next();
+
+    // next_bernoulli(threshold(p)) is true with probability p, without a floating-point draw
+    [[nodiscard]]
+    static threshold_type threshold(double probability) noexcept;
+    [[nodiscard]]
+    bool next_bernoulli(threshold_type threshold) noexcept;
+
+    // Available for engines providing jump(), such as TXoshiro256
+    void jump();
 };
 
-template<typename T>
-TRandom<T>::TRandom(T begin, T end)
-    : mt(rd())
+//
+
+inline uint64_t TXoshiro256::rotl(uint64_t x, int k) noexcept
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+inline TXoshiro256::TXoshiro256(uint64_t seed)
+{
+    // Spread the seed over the whole state with splitmix64
+    for (uint64_t& word : state)
+    {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        word = z ^ (z >> 31);
+    }
+}
+
+inline TXoshiro256::result_type TXoshiro256::operator()() noexcept
+{
+    const uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+}
+
+inline void TXoshiro256::jump() noexcept
+{
+    static const uint64_t polynomial[] = {
+            0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c
+    };
+
+    uint64_t jumped[4] = { 0, 0, 0, 0 };
+    for (uint64_t word : polynomial)
+    {
+        for (int bit = 0; bit < 64; bit++)
+        {
+            if (word & (uint64_t(1) << bit))
+            {
+                for (int i = 0; i < 4; i++)
+                    jumped[i] ^= state[i];
+            }
+            (*this)();
+        }
+    }
+
+    for (int i = 0; i < 4; i++)
+        state[i] = jumped[i];
+}
+
+template<typename T, class TEngine>
+uint64_t TRandom<T, TEngine>::entropy()
+{
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) ^ device();
+}
+
+template<typename T, class TEngine>
+TEngine TRandom<T, TEngine>::make_engine(uint64_t seed)
+{
+    if constexpr (std::is_same<TEngine, TXoshiro256>::value)
+    {
+        return TEngine(seed);
+    }
+    else
+    {
+        std::seed_seq sequence { static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) };
+        return TEngine(sequence);
+    }
+}
+
+template<typename T, class TEngine>
+TRandom<T, TEngine>::TRandom(T begin, T end)
+    : TRandom(begin, end, entropy())
+{}
+
+template<typename T, class TEngine>
+TRandom<T, TEngine>::TRandom(T begin, T end, uint64_t seed)
+    : engine(make_engine(seed))
     , dist(begin, end)
 {}
 
-template<typename T>
-T TRandom<T>::next()
+template<typename T, class TEngine>
+T TRandom<T, TEngine>::next()
+{
+    return dist(engine);
+}
+
+template<typename T, class TEngine>
+typename TRandom<T, TEngine>::threshold_type TRandom<T, TEngine>::threshold(double probability) noexcept
+{
+    // Outputs below the threshold count as successes. Certainty maps to the largest
+    // output, which next_bernoulli() accepts as well.
+    const threshold_type largest = TEngine::max() - TEngine::min();
+    const long double scaled = probability * (static_cast<long double>(largest) + 1.0L);
+    if (scaled <= 0.0L)
+        return 0;
+    if (scaled >= static_cast<long double>(largest))
+        return largest;
+    return static_cast<threshold_type>(scaled);
+}
+
+template<typename T, class TEngine>
+bool TRandom<T, TEngine>::next_bernoulli(threshold_type threshold) noexcept
+{
+    const threshold_type draw = engine() - TEngine::min();
+    return draw < threshold || threshold == TEngine::max() - TEngine::min();
+}
+
+template<typename T, class TEngine>
+void TRandom<T, TEngine>::jump()
 {
-    return dist(mt);
+    engine.jump();
 }
 
 #endif // __RANDOM_H__
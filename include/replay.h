@@ -0,0 +1,104 @@
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// Arrival log for TBasicCluster::replay(): a flat array of 64-bit little-endian
+// cycle numbers, one per task, in non-decreasing order. The file is mapped a
+// window at a time, so logs larger than memory stream through a fixed amount
+// of address space.
+class TArrivalFile {
+public:
+    static constexpr long long Never = std::numeric_limits<long long>::max();
+private:
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#else
+    int file;
+#endif
+    uint64_t records;
+    size_t window;
+
+    const unsigned char* view;
+    size_t viewSize;
+    // Records of the mapped window are [first, last), the next one is position
+    uint64_t first;
+    uint64_t last;
+    const unsigned char* data;
+    uint64_t position;
+
+    long long current;
+
+    static long long decode(const unsigned char* bytes) noexcept;
+    void accept(long long cycle);
+
+    void map(uint64_t record);
+    void unmap() noexcept;
+    void release() noexcept;
+    void load();
+public:
+    explicit TArrivalFile(const std::string& path, size_t window = size_t(64) << 20);
+    ~TArrivalFile();
+
+    TArrivalFile(const TArrivalFile&) = delete;
+    TArrivalFile& operator=(const TArrivalFile&) = delete;
+
+    // Cycle of the next arrival, Never once the log is exhausted
+    long long peek() const noexcept;
+    void pop();
+
+    void rewind();
+
+    uint64_t size() const noexcept;
+    uint64_t consumed() const noexcept;
+};
+
+//
+
+inline long long TArrivalFile::decode(const unsigned char* bytes) noexcept
+{
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--)
+        value = (value << 8) | bytes[i];
+    return static_cast<long long>(value);
+}
+
+inline void TArrivalFile::accept(long long cycle)
+{
+    // A value past the signed range wraps negative and fails the order check too
+    if (cycle < current)
+        throw std::runtime_error("Arrival file is not sorted by cycle");
+    current = cycle;
+}
+
+inline long long TArrivalFile::peek() const noexcept
+{
+    return current;
+}
+
+inline void TArrivalFile::pop()
+{
+    if (position == records)
+        return;
+
+    if (++position < last)
+        accept(decode(data + (position - first) * 8));
+    else
+        load();
+}
+
+inline uint64_t TArrivalFile::size() const noexcept
+{
+    return records;
+}
+
+inline uint64_t TArrivalFile::consumed() const noexcept
+{
+    return position;
+}
+
+#endif // __REPLAY_H__
@@ -0,0 +1,176 @@
+#ifndef __REPLICATION_H__
+#define __REPLICATION_H__
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "cluster.h"
+#include "random.h"
+
+// Sample mean with the half-width of its 95% confidence interval
+struct TEstimate {
+    double mean = 0.0;
+    double half_width = 0.0;
+};
+
+struct TReplicationSummary {
+    size_t replications = 0;
+    // Counters summed over all replications
+    TPerfStat total;
+
+    TEstimate total_tasks;
+    TEstimate rejection_share;
+    TEstimate service_cycles;
+    TEstimate idle_share;
+};
+
+// Runs independent copies of one cluster configuration on all cores.
+// Replication i always draws from the i-th jump() of the master seed and
+// results are merged in replication order, so the summary depends only on
+// the seed, never on the number of threads.
+template<class TModel = TCluster>
+class TReplicationRunner {
+private:
+    const size_t capacity;
+    const double intensity;
+    const double performance;
+    const long long cycles;
+
+    static double student_quantile(size_t degrees) noexcept;
+    static TEstimate estimate(const std::vector<double>& samples) noexcept;
+public:
+    TReplicationRunner(size_t capacity, double intensity, double performance, long long cycles);
+
+    [[nodiscard]]
+    std::vector<TPerfStat> run(size_t replications, uint64_t seed, unsigned threads = 0) const;
+
+    [[nodiscard]]
+    static TReplicationSummary summarize(const std::vector<TPerfStat>& stats);
+};
+
+//
+
+template<class TModel>
+TReplicationRunner<TModel>::TReplicationRunner(size_t capacity, double intensity, double performance, long long cycles)
+        : capacity(capacity)
+        , intensity(intensity)
+        , performance(performance)
+        , cycles(cycles)
+{}
+
+template<class TModel>
+std::vector<TPerfStat> TReplicationRunner<TModel>::run(size_t replications, uint64_t seed, unsigned threads) const
+{
+    std::vector<TRandom<double>> streams;
+    streams.reserve(replications);
+
+    TRandom<double> master(0.0, 1.0, seed);
+    for (size_t i = 0; i < replications; i++)
+    {
+        streams.push_back(master);
+        master.jump();
+    }
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(replications, 1)));
+
+    std::vector<TPerfStat> stats(replications);
+    std::atomic<size_t> next(0);
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < replications; i = next++)
+        {
+            TModel cluster(capacity, intensity, performance, streams[i]);
+            cluster.simulate(cycles);
+            stats[i] = cluster.stats();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool)
+        thread.join();
+
+    return stats;
+}
+
+template<class TModel>
+TReplicationSummary TReplicationRunner<TModel>::summarize(const std::vector<TPerfStat>& stats)
+{
+    TReplicationSummary summary;
+    summary.replications = stats.size();
+
+    std::vector<double> tasks, rejection, service, idle;
+    for (const TPerfStat& stat : stats)
+    {
+        summary.total += stat;
+
+        tasks.push_back(static_cast<double>(stat.total_tasks));
+        rejection.push_back(stat.rejection_share());
+        service.push_back(stat.service_cycles());
+        idle.push_back(stat.idle_share());
+    }
+
+    summary.total_tasks = estimate(tasks);
+    summary.rejection_share = estimate(rejection);
+    summary.service_cycles = estimate(service);
+    summary.idle_share = estimate(idle);
+    return summary;
+}
+
+template<class TModel>
+TEstimate TReplicationRunner<TModel>::estimate(const std::vector<double>& samples) noexcept
+{
+    TEstimate result;
+    const size_t n = samples.size();
+    if (n == 0)
+        return result;
+
+    double sum = 0.0;
+    for (double sample : samples)
+        sum += sample;
+    result.mean = sum / n;
+
+    if (n < 2)
+        return result;
+
+    double squares = 0.0;
+    for (double sample : samples)
+        squares += (sample - result.mean) * (sample - result.mean);
+
+    const double deviation = std::sqrt(squares / (n - 1));
+    result.half_width = student_quantile(n - 1) * deviation / std::sqrt(static_cast<double>(n));
+    return result;
+}
+
+template<class TModel>
+double TReplicationRunner<TModel>::student_quantile(size_t degrees) noexcept
+{
+    // Two-sided 95% quantiles of Student's t distribution
+    static const double table[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+
+    if (degrees <= 30)
+        return table[degrees - 1];
+    if (degrees <= 40)
+        return 2.021;
+    if (degrees <= 60)
+        return 2.000;
+    if (degrees <= 120)
+        return 1.980;
+    return 1.960;
+}
+
+#endif // __REPLICATION_H__
@@ -0,0 +1,446 @@
+#ifndef __RINGLIST_H__
+#define __RINGLIST_H__
+
+#include <stdexcept>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Double-ended list over a ring buffer. The capacity is kept a power of two,
+// so element i lives in slot (head + i) & (capacity - 1); both ends grow and
+// shrink in constant time and the storage doubles when it runs out.
+template<class T>
+class TRingList {
+private:
+    T *pMem;
+    size_t capacity;
+    size_t length;
+    size_t head;
+
+    static T* allocate(size_t count);
+    static void deallocate(T* mem) noexcept;
+    static size_t round_capacity(size_t count);
+
+    T* slot(size_t idx) const noexcept;
+    void destroy_elements() noexcept;
+
+    void expand_if_needed();
+    void relocate(size_t new_capacity);
+public:
+    typedef T value_type;
+
+    explicit TRingList(size_t initial_capacity = 8);
+
+    TRingList(const TRingList& src);
+    TRingList(TRingList&& src) noexcept;
+
+    ~TRingList();
+
+    [[nodiscard]]
+    size_t size() const noexcept;
+    [[nodiscard]]
+    bool empty() const noexcept;
+    // Number of slots allocated
+    [[nodiscard]]
+    size_t reserved() const noexcept;
+
+    void push_back(const T& element);
+    void push_back(T&& element);
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+
+    void push_front(const T& element);
+    void push_front(T&& element);
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args);
+
+    // Moves the shorter side of the list over the gap
+    void remove(size_t idx);
+    void pop_front();
+    void pop_back();
+
+    T& front();
+    T& back();
+
+    T& at(size_t idx);
+    const T& at(size_t idx) const;
+
+    T& operator[](size_t idx);
+    const T& operator[](size_t idx) const;
+
+    bool operator==(const TRingList& other) const noexcept;
+    bool operator!=(const TRingList& other) const noexcept;
+
+    TRingList& operator=(const TRingList& other);
+    TRingList& operator=(TRingList&& other) noexcept;
+
+    void clear();
+
+    void reserve(size_t len);
+    // Releases the slots beyond what max(len, size()) needs
+    void shrink(size_t len);
+
+    friend void swap(TRingList& lhs, TRingList& rhs) noexcept
+    {
+        std::swap(lhs.pMem, rhs.pMem);
+        std::swap(lhs.capacity, rhs.capacity);
+        std::swap(lhs.length, rhs.length);
+        std::swap(lhs.head, rhs.head);
+    }
+};
+
+//
+
+template<class T>
+T* TRingList<T>::allocate(size_t count)
+{
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+}
+
+template<class T>
+void TRingList<T>::deallocate(T* mem) noexcept
+{
+    ::operator delete(mem, std::align_val_t(alignof(T)));
+}
+
+template<class T>
+size_t TRingList<T>::round_capacity(size_t count)
+{
+    if (count > (std::numeric_limits<size_t>::max() >> 1) + 1)
+    {
+        throw std::length_error("List capacity is too large");
+    }
+
+    size_t rounded = 1;
+    while (rounded < count)
+        rounded <<= 1;
+    return rounded;
+}
+
+template<class T>
+TRingList<T>::TRingList(size_t initial_capacity)
+        : pMem(nullptr)
+        , capacity(round_capacity(initial_capacity > 0
+                                  ? initial_capacity
+                                  : throw std::invalid_argument("Initial list capacity should be greater than 0")))
+        , length(0)
+        , head(0)
+{
+    pMem = allocate(capacity);
+}
+
+template<class T>
+TRingList<T>::TRingList(const TRingList &src)
+        : pMem(allocate(src.capacity))
+        , capacity(src.capacity)
+        , length(0)
+        , head(0)
+{
+    try
+    {
+        for (; length < src.length; length++)
+            new (pMem + length) T(src[length]);
+    }
+    catch (...)
+    {
+        destroy_elements();
+        deallocate(pMem);
+        throw;
+    }
+}
+
+template<class T>
+TRingList<T>::TRingList(TRingList &&src) noexcept
+        : pMem(nullptr)
+        , capacity(0)
+        , length(0)
+        , head(0)
+{
+    swap(*this, src);
+}
+
+template<class T>
+TRingList<T>::~TRingList()
+{
+    destroy_elements();
+    deallocate(pMem);
+}
+
+template<class T>
+T* TRingList<T>::slot(size_t idx) const noexcept
+{
+    return pMem + ((head + idx) & (capacity - 1));
+}
+
+template<class T>
+void TRingList<T>::destroy_elements() noexcept
+{
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        for (size_t i = 0; i < length; i++)
+            slot(i)->~T();
+    }
+}
+
+template<class T>
+void TRingList<T>::expand_if_needed()
+{
+    if (length < capacity) return;
+
+    relocate(capacity > 0 ? capacity * 2 : 1);
+}
+
+template<class T>
+void TRingList<T>::relocate(size_t new_capacity)
+{
+    assert(new_capacity >= length && "Capacity is too small");
+
+    T *mem = allocate(new_capacity);
+    // The elements are at most two contiguous runs: up to the end of the buffer and the wrapped rest
+    const size_t run = std::min(length, capacity - head);
+    if constexpr (std::is_trivially_copyable<T>::value)
+    {
+        std::memcpy(static_cast<void*>(mem), pMem + head, run * sizeof(T));
+        std::memcpy(static_cast<void*>(mem + run), pMem, (length - run) * sizeof(T));
+    }
+    else
+    {
+        try
+        {
+            std::uninitialized_move(pMem + head, pMem + head + run, mem);
+            try
+            {
+                std::uninitialized_move(pMem, pMem + length - run, mem + run);
+            }
+            catch (...)
+            {
+                std::destroy(mem, mem + run);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            deallocate(mem);
+            throw;
+        }
+        destroy_elements();
+    }
+
+    deallocate(pMem);
+    pMem = mem;
+    capacity = new_capacity;
+    head = 0;
+}
+
+template<class T>
+size_t TRingList<T>::size() const noexcept
+{
+    return length;
+}
+
+template<class T>
+bool TRingList<T>::empty() const noexcept
+{
+    return length == 0;
+}
+
+template<class T>
+size_t TRingList<T>::reserved() const noexcept
+{
+    return capacity;
+}
+
+template<class T>
+void TRingList<T>::push_back(const T &element)
+{
+    emplace_back(element);
+}
+
+template<class T>
+void TRingList<T>::push_back(T &&element)
+{
+    emplace_back(std::move(element));
+}
+
+template<class T>
+template<typename... Args>
+T& TRingList<T>::emplace_back(Args&&... args)
+{
+    expand_if_needed();
+    T *element = new (slot(length)) T(std::forward<Args>(args)...);
+    length++;
+    return *element;
+}
+
+template<class T>
+void TRingList<T>::push_front(const T &element)
+{
+    emplace_front(element);
+}
+
+template<class T>
+void TRingList<T>::push_front(T &&element)
+{
+    emplace_front(std::move(element));
+}
+
+template<class T>
+template<typename... Args>
+T& TRingList<T>::emplace_front(Args&&... args)
+{
+    expand_if_needed();
+    const size_t new_head = (head - 1) & (capacity - 1);
+    T *element = new (pMem + new_head) T(std::forward<Args>(args)...);
+    head = new_head;
+    length++;
+    return *element;
+}
+
+template<class T>
+void TRingList<T>::remove(size_t idx)
+{
+    assert(idx < length && "Index is out of range");
+
+    if (idx < length / 2)
+    {
+        for (size_t i = idx; i > 0; i--)
+            *slot(i) = std::move(*slot(i - 1));
+        pop_front();
+    }
+    else
+    {
+        for (size_t i = idx; i + 1 < length; i++)
+            *slot(i) = std::move(*slot(i + 1));
+        pop_back();
+    }
+}
+
+template<class T>
+void TRingList<T>::pop_front()
+{
+    assert(length && "List is empty");
+
+    pMem[head].~T();
+    head = (head + 1) & (capacity - 1);
+    length--;
+}
+
+template<class T>
+void TRingList<T>::pop_back()
+{
+    assert(length && "List is empty");
+
+    slot(length - 1)->~T();
+    length--;
+}
+
+template<class T>
+T &TRingList<T>::front()
+{
+    return pMem[head];
+}
+
+template<class T>
+T &TRingList<T>::back()
+{
+    return *slot(length - 1);
+}
+
+template<class T>
+T &TRingList<T>::at(const size_t idx)
+{
+    return const_cast<T&>(std::as_const(at(idx)));
+}
+
+template<class T>
+const T &TRingList<T>::at(const size_t idx) const
+{
+    assert(idx < length && "Index is out of range");
+    return (*this)[idx];
+}
+
+template<class T>
+T &TRingList<T>::operator[](const size_t idx)
+{
+    return const_cast<T&>(std::as_const(*this)[idx]);
+}
+
+template<class T>
+const T &TRingList<T>::operator[](const size_t idx) const
+{
+    return *slot(idx);
+}
+
+template<class T>
+bool TRingList<T>::operator==(const TRingList &other) const noexcept
+{
+    if (this == &other)
+        return true;
+
+    if (length != other.length)
+        return false;
+
+    for (size_t i = 0; i < length; i++)
+        if ((*this)[i] != other[i])
+            return false;
+
+    return true;
+}
+
+template<class T>
+bool TRingList<T>::operator!=(const TRingList &other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<class T>
+TRingList<T>& TRingList<T>::operator=(const TRingList &other)
+{
+    if (this == &other)
+        return *this;
+
+    TRingList<T> tmp(other);
+    swap(*this, tmp);
+    return *this;
+}
+
+template<class T>
+TRingList<T>& TRingList<T>::operator=(TRingList &&other) noexcept
+{
+    swap(*this, other);
+    return *this;
+}
+
+template<class T>
+void TRingList<T>::clear()
+{
+    destroy_elements();
+    length = 0;
+    head = 0;
+}
+
+template<class T>
+void TRingList<T>::reserve(size_t len)
+{
+    if (len > capacity) {
+        relocate(round_capacity(len));
+    }
+}
+
+template<class T>
+void TRingList<T>::shrink(size_t len)
+{
+    const size_t new_capacity = round_capacity(std::max<size_t>({ len, length, 1 }));
+    if (new_capacity < capacity) {
+        relocate(new_capacity);
+    }
+}
+
+#endif // __RINGLIST_H__
@@ -0,0 +1,371 @@
+#ifndef __STATIC_CIRCULAR_QUEUE_H__
+#define __STATIC_CIRCULAR_QUEUE_H__
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Occupied range of a ring of N slots, element i of the queue is in slot position(idxBegin + i)
+template<size_t N>
+class TStaticQueueRange
+{
+protected:
+    size_t length = 0;
+    size_t idxBegin = 0;
+
+    // idx is below 2N, so wrapping it is a mask or a single subtraction
+    static constexpr size_t position(size_t idx) noexcept
+    {
+        if constexpr ((N & (N - 1)) == 0)
+            return idx & (N - 1);
+        else
+            return idx >= N ? idx - N : idx;
+    }
+};
+
+// Slots of TStaticCircularQueue. Plain element types live in an ordinary
+// array, which keeps the queue a literal type usable in constant expressions;
+// the others get raw storage constructed and destroyed slot by slot.
+template<typename T, size_t N, bool Plain = std::is_trivially_copyable<T>::value
+                                            && std::is_trivially_destructible<T>::value
+                                            && std::is_default_constructible<T>::value>
+class TStaticQueueSlots : public TStaticQueueRange<N>
+{
+private:
+    T slots[N] {};
+protected:
+    constexpr T& element(size_t idx) noexcept { return slots[idx]; }
+    constexpr const T& element(size_t idx) const noexcept { return slots[idx]; }
+
+    template<typename... Args>
+    constexpr T& construct(size_t idx, Args&&... args)
+    {
+        return slots[idx] = T(std::forward<Args>(args)...);
+    }
+
+    constexpr void destroy(size_t) noexcept {}
+};
+
+template<typename T, size_t N>
+class TStaticQueueSlots<T, N, false> : public TStaticQueueRange<N>
+{
+private:
+    std::aligned_storage_t<sizeof(T), alignof(T)> slots[N];
+
+    void destroy_elements() noexcept;
+protected:
+    using TStaticQueueRange<N>::length;
+    using TStaticQueueRange<N>::idxBegin;
+    using TStaticQueueRange<N>::position;
+
+    T& element(size_t idx) noexcept { return *std::launder(reinterpret_cast<T*>(&slots[idx])); }
+    const T& element(size_t idx) const noexcept { return *std::launder(reinterpret_cast<const T*>(&slots[idx])); }
+
+    template<typename... Args>
+    T& construct(size_t idx, Args&&... args)
+    {
+        return *new (&slots[idx]) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(size_t idx) noexcept { element(idx).~T(); }
+
+    TStaticQueueSlots() = default;
+    TStaticQueueSlots(const TStaticQueueSlots& src);
+    // The source is left empty
+    TStaticQueueSlots(TStaticQueueSlots&& src) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    TStaticQueueSlots& operator=(const TStaticQueueSlots&) = delete;
+
+    ~TStaticQueueSlots();
+};
+
+// Bounded FIFO queue with its slots inline, so an instance needs no heap
+// allocation and lives wherever its owner does. N is the storage size known at
+// compile time; ring positions wrap with a mask when N is a power of two. The
+// constructor may set a smaller capacity, which makes it a drop-in for
+// TCircularQueue and a TBasicCluster task queue through an alias such as
+// template<typename T> using TCoreQueue = TStaticCircularQueue<T, 64>;
+template<typename T, size_t N>
+class TStaticCircularQueue : private TStaticQueueSlots<T, N>
+{
+    static_assert(N > 0, "Queue needs at least one slot");
+
+    using TStaticQueueRange<N>::length;
+    using TStaticQueueRange<N>::idxBegin;
+    using TStaticQueueRange<N>::position;
+    using TStaticQueueSlots<T, N>::element;
+    using TStaticQueueSlots<T, N>::construct;
+    using TStaticQueueSlots<T, N>::destroy;
+private:
+    const size_t capacity;
+
+    constexpr size_t last_index() const noexcept;
+    constexpr void require_not_empty() const;
+public:
+    typedef T value_type;
+
+    constexpr explicit TStaticCircularQueue(size_t capacity = N);
+
+    constexpr bool full() const noexcept;
+    constexpr bool empty() const noexcept;
+
+    constexpr T& top();
+    constexpr T& bottom();
+
+    constexpr void push(const T& element);
+    constexpr void push(T&& element);
+
+    template<typename... Args>
+    constexpr T& emplace(Args&&... args);
+
+    constexpr void pop();
+    [[nodiscard]]
+    constexpr T pop_element();
+
+    constexpr void shift();
+    [[nodiscard]]
+    constexpr T poll();
+    constexpr T& peek();
+
+    // False instead of std::overflow_error on a full queue or std::logic_error on an empty one
+    constexpr bool try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value);
+    constexpr bool try_push(T&& element) noexcept(std::is_nothrow_move_constructible<T>::value);
+    constexpr bool try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+    constexpr size_t size() const noexcept;
+    constexpr size_t max_size() const noexcept;
+};
+
+//
+
+template<typename T, size_t N>
+TStaticQueueSlots<T, N, false>::TStaticQueueSlots(const TStaticQueueSlots& src)
+{
+    try
+    {
+        for (; length < src.length; length++)
+            construct(length, src.element(position(src.idxBegin + length)));
+    }
+    catch (...)
+    {
+        destroy_elements();
+        throw;
+    }
+}
+
+template<typename T, size_t N>
+TStaticQueueSlots<T, N, false>::TStaticQueueSlots(TStaticQueueSlots&& src)
+        noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    if constexpr (std::is_nothrow_move_constructible<T>::value)
+    {
+        for (; length < src.length; length++)
+            construct(length, std::move(src.element(position(src.idxBegin + length))));
+    }
+    else
+    {
+        try
+        {
+            for (; length < src.length; length++)
+                construct(length, std::move(src.element(position(src.idxBegin + length))));
+        }
+        catch (...)
+        {
+            destroy_elements();
+            throw;
+        }
+    }
+
+    src.destroy_elements();
+    src.length = 0;
+    src.idxBegin = 0;
+}
+
+template<typename T, size_t N>
+TStaticQueueSlots<T, N, false>::~TStaticQueueSlots()
+{
+    destroy_elements();
+}
+
+template<typename T, size_t N>
+void TStaticQueueSlots<T, N, false>::destroy_elements() noexcept
+{
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        for (size_t i = 0; i < length; i++)
+            destroy(position(idxBegin + i));
+    }
+}
+
+template<typename T, size_t N>
+constexpr TStaticCircularQueue<T, N>::TStaticCircularQueue(size_t capacity)
+        : capacity(capacity > 0 && capacity <= N
+                   ? capacity
+                   : throw std::invalid_argument("Queue capacity should be between 1 and the slot count"))
+{}
+
+template<typename T, size_t N>
+constexpr size_t TStaticCircularQueue<T, N>::last_index() const noexcept
+{
+    return position(idxBegin + length - 1);
+}
+
+template<typename T, size_t N>
+constexpr void TStaticCircularQueue<T, N>::require_not_empty() const
+{
+    if (empty())
+        throw std::logic_error("Queue is empty");
+}
+
+template<typename T, size_t N>
+constexpr bool TStaticCircularQueue<T, N>::full() const noexcept
+{
+    return length == capacity;
+}
+
+template<typename T, size_t N>
+constexpr bool TStaticCircularQueue<T, N>::empty() const noexcept
+{
+    return length == 0;
+}
+
+template<typename T, size_t N>
+constexpr T& TStaticCircularQueue<T, N>::top()
+{
+    require_not_empty();
+    return element(last_index());
+}
+
+template<typename T, size_t N>
+constexpr T& TStaticCircularQueue<T, N>::bottom()
+{
+    require_not_empty();
+    return element(idxBegin);
+}
+
+template<typename T, size_t N>
+constexpr void TStaticCircularQueue<T, N>::push(const T& element)
+{
+    emplace(element);
+}
+
+template<typename T, size_t N>
+constexpr void TStaticCircularQueue<T, N>::push(T&& element)
+{
+    emplace(std::move(element));
+}
+
+template<typename T, size_t N>
+template<typename... Args>
+constexpr T& TStaticCircularQueue<T, N>::emplace(Args&&... args)
+{
+    if (full())
+    {
+        throw std::overflow_error("Queue is full");
+    }
+
+    T& element = construct(position(idxBegin + length), std::forward<Args>(args)...);
+    length++;
+    return element;
+}
+
+template<typename T, size_t N>
+constexpr void TStaticCircularQueue<T, N>::pop()
+{
+    require_not_empty();
+
+    destroy(last_index());
+    length--;
+}
+
+template<typename T, size_t N>
+constexpr T TStaticCircularQueue<T, N>::pop_element()
+{
+    require_not_empty();
+
+    const size_t idx = last_index();
+    T element = std::move(this->element(idx));
+    destroy(idx);
+    length--;
+    return element;
+}
+
+template<typename T, size_t N>
+constexpr void TStaticCircularQueue<T, N>::shift()
+{
+    require_not_empty();
+
+    destroy(idxBegin);
+    idxBegin = position(idxBegin + 1);
+    length--;
+}
+
+template<typename T, size_t N>
+constexpr T TStaticCircularQueue<T, N>::poll()
+{
+    require_not_empty();
+
+    T element = std::move(this->element(idxBegin));
+    destroy(idxBegin);
+    idxBegin = position(idxBegin + 1);
+    length--;
+    return element;
+}
+
+template<typename T, size_t N>
+constexpr T& TStaticCircularQueue<T, N>::peek()
+{
+    require_not_empty();
+    return element(idxBegin);
+}
+
+template<typename T, size_t N>
+constexpr bool TStaticCircularQueue<T, N>::try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value)
+{
+    if (full())
+        return false;
+
+    construct(position(idxBegin + length), element);
+    length++;
+    return true;
+}
+
+template<typename T, size_t N>
+constexpr bool TStaticCircularQueue<T, N>::try_push(T&& element) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    if (full())
+        return false;
+
+    construct(position(idxBegin + length), std::move(element));
+    length++;
+    return true;
+}
+
+template<typename T, size_t N>
+constexpr bool TStaticCircularQueue<T, N>::try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+    if (empty())
+        return false;
+
+    element = std::move(this->element(idxBegin));
+    destroy(idxBegin);
+    idxBegin = position(idxBegin + 1);
+    length--;
+    return true;
+}
+
+template<typename T, size_t N>
+constexpr size_t TStaticCircularQueue<T, N>::size() const noexcept
+{
+    return length;
+}
+
+template<typename T, size_t N>
+constexpr size_t TStaticCircularQueue<T, N>::max_size() const noexcept
+{
+    return capacity;
+}
+
+#endif // __STATIC_CIRCULAR_QUEUE_H__
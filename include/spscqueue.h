@@ -0,0 +1,289 @@
+#ifndef __SPSC_QUEUE_H__
+#define __SPSC_QUEUE_H__
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+// Bounded queue for exactly one producer thread and one consumer thread.
+// push() may only be called by the producer, shift()/poll()/peek() only by the consumer.
+//
+// With Padded each side's index sits on a cache line of its own together with
+// the last value that side saw of the other index. A thread reads the line the
+// other one writes only when its copy says the queue is full or empty, so
+// in steady state the two cores do not trade lines on every element. Without
+// Padded both indices share a line and are read on every call, which is the
+// layout the benchmarks compare against.
+template<typename T, bool Padded = true>
+class TSpscQueue
+{
+public:
+    static constexpr size_t CacheLineSize = 64;
+private:
+    // The element buffer starts on a line of its own as well
+    static constexpr size_t BufferAlignment = std::max(alignof(T), CacheLineSize);
+
+    struct TSide {
+        // Free-running, slot is (index % capacity)
+        std::atomic<size_t> index { 0 };
+        // Other side's index as this side last read it
+        size_t cached = 0;
+    };
+    struct alignas(CacheLineSize) TPaddedSide : TSide {};
+
+    const size_t capacity;
+    T* const buffer;
+
+    // The producer owns end, the consumer owns begin
+    std::conditional_t<Padded, TPaddedSide, TSide> end;
+    std::conditional_t<Padded, TPaddedSide, TSide> begin;
+
+    static T* allocate(size_t count);
+    static void deallocate(T* mem) noexcept;
+
+    T* slot(size_t idx) const noexcept;
+
+    // Producer side: whether slot idx is free
+    bool has_room(size_t idx) noexcept;
+    // Consumer side: whether slot idx holds an element
+    bool has_element(size_t idx) noexcept;
+    void require_element(size_t idx);
+public:
+    typedef T value_type;
+
+    explicit TSpscQueue(size_t capacity);
+
+    TSpscQueue(const TSpscQueue&) = delete;
+    TSpscQueue& operator=(const TSpscQueue&) = delete;
+
+    ~TSpscQueue();
+
+    bool full() const noexcept;
+    bool empty() const noexcept;
+
+    void push(const T& element);
+    void push(T&& element);
+
+    template<typename... Args>
+    T& emplace(Args&&... args);
+
+    void shift();
+    [[nodiscard]]
+    T poll();
+    T& peek();
+
+    // False instead of std::overflow_error on a full queue or std::logic_error on an empty one
+    bool try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value);
+    bool try_push(T&& element) noexcept(std::is_nothrow_move_constructible<T>::value);
+    bool try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+    size_t size() const noexcept;
+    size_t max_size() const noexcept;
+};
+
+//
+
+template<typename T, bool Padded>
+T* TSpscQueue<T, Padded>::allocate(size_t count)
+{
+    if (count == 0)
+    {
+        throw std::invalid_argument("Queue capacity should be greater than 0");
+    }
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(BufferAlignment)));
+}
+
+template<typename T, bool Padded>
+void TSpscQueue<T, Padded>::deallocate(T* mem) noexcept
+{
+    ::operator delete(mem, std::align_val_t(BufferAlignment));
+}
+
+template<typename T, bool Padded>
+TSpscQueue<T, Padded>::TSpscQueue(size_t capacity)
+        : capacity(capacity)
+        , buffer(allocate(capacity))
+{}
+
+template<typename T, bool Padded>
+TSpscQueue<T, Padded>::~TSpscQueue()
+{
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        const size_t last = end.index.load(std::memory_order_acquire);
+        for (size_t i = begin.index.load(std::memory_order_acquire); i != last; i++)
+            slot(i)->~T();
+    }
+    deallocate(buffer);
+}
+
+template<typename T, bool Padded>
+T* TSpscQueue<T, Padded>::slot(size_t idx) const noexcept
+{
+    return buffer + idx % capacity;
+}
+
+template<typename T, bool Padded>
+bool TSpscQueue<T, Padded>::has_room(size_t idx) noexcept
+{
+    if constexpr (Padded)
+    {
+        if (idx - end.cached < capacity)
+            return true;
+
+        end.cached = begin.index.load(std::memory_order_acquire);
+        return idx - end.cached < capacity;
+    }
+    else
+    {
+        return idx - begin.index.load(std::memory_order_acquire) < capacity;
+    }
+}
+
+template<typename T, bool Padded>
+bool TSpscQueue<T, Padded>::has_element(size_t idx) noexcept
+{
+    if constexpr (Padded)
+    {
+        if (begin.cached != idx)
+            return true;
+
+        begin.cached = end.index.load(std::memory_order_acquire);
+        return begin.cached != idx;
+    }
+    else
+    {
+        return end.index.load(std::memory_order_acquire) != idx;
+    }
+}
+
+template<typename T, bool Padded>
+void TSpscQueue<T, Padded>::require_element(size_t idx)
+{
+    if (!has_element(idx))
+        throw std::logic_error("Queue is empty");
+}
+
+template<typename T, bool Padded>
+bool TSpscQueue<T, Padded>::full() const noexcept
+{
+    return end.index.load(std::memory_order_acquire) - begin.index.load(std::memory_order_acquire) == capacity;
+}
+
+template<typename T, bool Padded>
+bool TSpscQueue<T, Padded>::empty() const noexcept
+{
+    return end.index.load(std::memory_order_acquire) == begin.index.load(std::memory_order_acquire);
+}
+
+template<typename T, bool Padded>
+void TSpscQueue<T, Padded>::push(const T& element)
+{
+    emplace(element);
+}
+
+template<typename T, bool Padded>
+void TSpscQueue<T, Padded>::push(T&& element)
+{
+    emplace(std::move(element));
+}
+
+template<typename T, bool Padded>
+template<typename... Args>
+T& TSpscQueue<T, Padded>::emplace(Args&&... args)
+{
+    const size_t idx = end.index.load(std::memory_order_relaxed);
+    if (!has_room(idx))
+    {
+        throw std::overflow_error("Queue is full");
+    }
+
+    T& element = *new (slot(idx)) T(std::forward<Args>(args)...);
+    end.index.store(idx + 1, std::memory_order_release);
+    return element;
+}
+
+template<typename T, bool Padded>
+void TSpscQueue<T, Padded>::shift()
+{
+    const size_t idx = begin.index.load(std::memory_order_relaxed);
+    require_element(idx);
+
+    slot(idx)->~T();
+    begin.index.store(idx + 1, std::memory_order_release);
+}
+
+template<typename T, bool Padded>
+T TSpscQueue<T, Padded>::poll()
+{
+    const size_t idx = begin.index.load(std::memory_order_relaxed);
+    require_element(idx);
+
+    T element = std::move(*slot(idx));
+    slot(idx)->~T();
+    begin.index.store(idx + 1, std::memory_order_release);
+
+    return element;
+}
+
+template<typename T, bool Padded>
+bool TSpscQueue<T, Padded>::try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value)
+{
+    const size_t idx = end.index.load(std::memory_order_relaxed);
+    if (!has_room(idx))
+        return false;
+
+    new (slot(idx)) T(element);
+    end.index.store(idx + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, bool Padded>
+bool TSpscQueue<T, Padded>::try_push(T&& element) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    const size_t idx = end.index.load(std::memory_order_relaxed);
+    if (!has_room(idx))
+        return false;
+
+    new (slot(idx)) T(std::move(element));
+    end.index.store(idx + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, bool Padded>
+bool TSpscQueue<T, Padded>::try_poll(T& element) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+    const size_t idx = begin.index.load(std::memory_order_relaxed);
+    if (!has_element(idx))
+        return false;
+
+    element = std::move(*slot(idx));
+    slot(idx)->~T();
+    begin.index.store(idx + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, bool Padded>
+T& TSpscQueue<T, Padded>::peek()
+{
+    const size_t idx = begin.index.load(std::memory_order_relaxed);
+    require_element(idx);
+    return *slot(idx);
+}
+
+template<typename T, bool Padded>
+size_t TSpscQueue<T, Padded>::size() const noexcept
+{
+    const size_t first = begin.index.load(std::memory_order_acquire);
+    return end.index.load(std::memory_order_acquire) - first;
+}
+
+template<typename T, bool Padded>
+size_t TSpscQueue<T, Padded>::max_size() const noexcept
+{
+    return capacity;
+}
+
+#endif // __SPSC_QUEUE_H__
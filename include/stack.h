@@ -2,7 +2,9 @@
 #define __STACK_H__
 
 #include "arraylist.h"
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 
 template<typename T, template<typename> class TContainer>
 class TStack
@@ -14,17 +16,31 @@ protected:
 public:
     typedef T value_type;
 
+    // Adding an element may move the others to new storage, so try_push()
+    // only keeps exceptions in when moving elements cannot throw either
+    static constexpr bool NothrowRelocate = std::is_nothrow_move_constructible<T>::value
+                                            && std::is_nothrow_move_assignable<T>::value;
+
     explicit TStack(size_t initial_capacity = 8);
 
     void push(const T& element);
     void push(T&& element);
 
+    template<typename... Args>
+    T& emplace(Args&&... args);
+
     T& top();
 
     void pop();
     [[nodiscard]]
     T pop_element();
 
+    // Report failure instead of throwing: try_push() is false when memory runs out,
+    // try_pop() is false on an empty stack and leaves element untouched
+    bool try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value && NothrowRelocate);
+    bool try_push(T&& element) noexcept(NothrowRelocate);
+    bool try_pop(T& element) noexcept(std::is_nothrow_move_assignable<T>::value);
+
     bool empty() const noexcept(noexcept(list.empty()));
     size_t size() const noexcept(noexcept(list.size()));
 };
@@ -45,7 +61,14 @@ void TStack<T, TContainer>::push(const T &element)
 template<typename T, template<typename> class TContainer>
 void TStack<T, TContainer>::push(T &&element)
 {
-    push(element);
+    list.push_back(std::move(element));
+}
+
+template<typename T, template<typename> class TContainer>
+template<typename... Args>
+T &TStack<T, TContainer>::emplace(Args&&... args)
+{
+    return list.emplace_back(std::forward<Args>(args)...);
 }
 
 template<typename T, template<typename> class TContainer>
@@ -67,11 +90,50 @@ T TStack<T, TContainer>::pop_element()
 {
     require_not_empty();
 
-    T element = list[list.size() - 1];
+    T element = std::move(list.back());
     list.remove(list.size() - 1);
     return element;
 }
 
+template<typename T, template<typename> class TContainer>
+bool TStack<T, TContainer>::try_push(const T& element) noexcept(std::is_nothrow_copy_constructible<T>::value && NothrowRelocate)
+{
+    try
+    {
+        list.push_back(element);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+    return true;
+}
+
+template<typename T, template<typename> class TContainer>
+bool TStack<T, TContainer>::try_push(T&& element) noexcept(NothrowRelocate)
+{
+    try
+    {
+        list.push_back(std::move(element));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+    return true;
+}
+
+template<typename T, template<typename> class TContainer>
+bool TStack<T, TContainer>::try_pop(T& element) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+    if (list.empty())
+        return false;
+
+    element = std::move(list.back());
+    list.remove(list.size() - 1);
+    return true;
+}
+
 template<typename T, template<typename> class TContainer>
 bool TStack<T, TContainer>::empty() const noexcept(noexcept(list.empty()))
 {
@@ -0,0 +1,51 @@
+#ifndef __SWEEP_H__
+#define __SWEEP_H__
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "cluster.h"
+
+struct TSweepPoint {
+    size_t capacity = 0;
+    double intensity = 0.0;
+    double performance = 0.0;
+    long long cycles = 0;
+};
+
+struct TSweepResult {
+    TSweepPoint point;
+    TPerfStat stat;
+};
+
+// Batch of cluster experiments. Every point runs a plain TCluster, point i
+// drawing from the i-th jump() of the seed, so a sweep is reproducible no
+// matter how its points were spread over the threads.
+class TSweep {
+private:
+    std::vector<TSweepPoint> points;
+public:
+    // One experiment per line: capacity intensity performance cycles.
+    // A field may list several comma-separated values, the line then
+    // expands to every combination of them. '#' starts a comment.
+    static TSweep parse(std::istream& config);
+
+    void add(const TSweepPoint& point);
+    const std::vector<TSweepPoint>& get_points() const noexcept;
+
+    // Points are handed out longest first; a worker that runs out of its
+    // own points steals the shortest ones left to the others
+    [[nodiscard]]
+    std::vector<TSweepResult> run(uint64_t seed, unsigned threads = 0) const;
+
+    // Expected counters of every point from TClusterChain, without simulating
+    [[nodiscard]]
+    std::vector<TSweepResult> solve() const;
+
+    static void write_csv(std::ostream& out, const std::vector<TSweepResult>& results);
+    static void write_json(std::ostream& out, const std::vector<TSweepResult>& results);
+};
+
+#endif // __SWEEP_H__
@@ -0,0 +1,161 @@
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class TTraceEvent : uint8_t {
+    Arrival,
+    Reject,
+    Start,
+    Complete,
+    Idle
+};
+
+// For Idle, value is the number of idle cycles from cycle on; for the others it is the task id
+struct TTraceRecord {
+    TTraceEvent event = TTraceEvent::Arrival;
+    long long cycle = 0;
+    long long value = 0;
+};
+
+// Writes cluster events to a compact binary file. A record is an event tag
+// followed by zigzag varints of the cycle delta and of the task id delta,
+// so a typical event takes three bytes. Records are encoded into one buffer
+// while a background thread writes out the other. Consecutive idle cycles
+// are merged into a single record.
+class TTraceWriter {
+private:
+    // Tag byte plus two 64-bit varints
+    static constexpr size_t MaxRecordSize = 1 + 10 + 10;
+
+    std::ofstream file;
+
+    std::vector<char> front;
+    size_t used;
+    std::vector<char> back;
+    size_t backUsed;
+
+    long long lastCycle;
+    long long lastTask;
+
+    // Idle run waiting to be merged with the next idle cycle
+    long long idleFrom;
+    long long idleCycles;
+
+    std::mutex guard;
+    std::condition_variable changed;
+    bool pending;
+    bool closing;
+    bool failed;
+    std::thread writer;
+
+    static uint64_t zigzag(long long value) noexcept;
+
+    void put_varint(uint64_t value) noexcept;
+    void put(TTraceEvent event, long long cycle, uint64_t value) noexcept;
+    void require_open() const;
+    void flush_idle();
+    void submit();
+    void write_loop();
+public:
+    static const char Magic[4];
+    static constexpr uint8_t Version = 1;
+
+    explicit TTraceWriter(const std::string& path, size_t bufferSize = size_t(1) << 20);
+    ~TTraceWriter();
+
+    TTraceWriter(const TTraceWriter&) = delete;
+    TTraceWriter& operator=(const TTraceWriter&) = delete;
+
+    // Throw std::logic_error after close()
+    void record(TTraceEvent event, long long cycle, long long task);
+    void record_idle(long long cycle, long long cycles);
+
+    // Writes out everything recorded so far and stops the writer thread
+    void close();
+};
+
+class TTraceReader {
+private:
+    std::ifstream file;
+
+    long long lastCycle;
+    long long lastTask;
+
+    bool get_varint(uint64_t& value);
+public:
+    explicit TTraceReader(const std::string& path);
+
+    // False at the end of the trace
+    bool next(TTraceRecord& record);
+};
+
+const char* to_string(TTraceEvent event) noexcept;
+
+//
+
+inline uint64_t TTraceWriter::zigzag(long long value) noexcept
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline void TTraceWriter::put_varint(uint64_t value) noexcept
+{
+    while (value >= 0x80)
+    {
+        front[used++] = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    front[used++] = static_cast<char>(value);
+}
+
+inline void TTraceWriter::put(TTraceEvent event, long long cycle, uint64_t value) noexcept
+{
+    front[used++] = static_cast<char>(event);
+    put_varint(zigzag(cycle - lastCycle));
+    put_varint(value);
+    lastCycle = cycle;
+}
+
+inline void TTraceWriter::require_open() const
+{
+    // Only the recording thread sets closing, so it may read it without the lock
+    if (closing)
+        throw std::logic_error("Trace writer is closed");
+}
+
+inline void TTraceWriter::record(TTraceEvent event, long long cycle, long long task)
+{
+    require_open();
+    if (idleCycles)
+        flush_idle();
+    if (front.size() - used < MaxRecordSize)
+        submit();
+
+    put(event, cycle, zigzag(task - lastTask));
+    lastTask = task;
+}
+
+inline void TTraceWriter::record_idle(long long cycle, long long cycles)
+{
+    require_open();
+    if (idleCycles && idleFrom + idleCycles == cycle)
+    {
+        idleCycles += cycles;
+        return;
+    }
+
+    if (idleCycles)
+        flush_idle();
+    idleFrom = cycle;
+    idleCycles = cycles;
+}
+
+#endif // __TRACE_H__
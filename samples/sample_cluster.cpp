@@ -1,11 +1,13 @@
 ﻿#include <iostream>
 #include <cmath>
+#include <memory>
 
 #include "cluster.h"
 
 using namespace std;
 
-int main()
+// An optional argument names a file to write the binary event trace to
+int main(int argc, char** argv)
 {
     setlocale(LC_ALL, "Russian");
     setlocale(LC_NUMERIC, "en_US.UTF-8");
@@ -23,7 +25,7 @@ int main()
     cout << "Производительность кластера: ";
     cin >> performance;
 
-    int T;
+    long long T;
     cout << "Количество тактов: ";
     cin >> T;
 
@@ -32,16 +34,33 @@ int main()
 
     TCluster cluster(capacity, intensity, performance);
 
-    for (int i = 0; i < T; i++)
+    try
     {
-        cluster.generate_tasks();
-        cluster.perform_cycle();
+        unique_ptr<TTraceWriter> tracer;
+        if (argc > 1)
+        {
+            tracer = make_unique<TTraceWriter>(argv[1]);
+            cluster.set_tracer(tracer.get());
+        }
+
+        cluster.simulate(T);
+
+        if (tracer)
+        {
+            cluster.set_tracer(nullptr);
+            tracer->close();
+        }
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
     }
 
     const auto& stat = cluster.stats();
     //
     const double rejection_percentage = static_cast<double>(stat.rejected_tasks) / stat.total_tasks;
-    const int average_cycles = static_cast<int>(round(static_cast<double>(stat.cycles - stat.idle_cycles) / stat.completed_tasks));
+    const long long average_cycles = static_cast<long long>(round(static_cast<double>(stat.cycles - stat.idle_cycles) / stat.completed_tasks));
     const double idle_percentage = static_cast<double>(stat.idle_cycles) / stat.cycles;
     //
 
@@ -50,5 +69,11 @@ int main()
     cout << "Среднее количество тактов выполнения задания: " << average_cycles << endl;
     cout << "Количество тактов простоя процессора из-за отсутствия заданий: " << (100 * idle_percentage) << "%" << endl;
 
+    const auto& latency = cluster.latency();
+    cout << "Время ожидания задания в очереди (p50 / p99 / p999), тактов: "
+         << latency.wait.p50() << " / " << latency.wait.p99() << " / " << latency.wait.p999() << endl;
+    cout << "Время пребывания задания в системе (p50 / p99 / p999), тактов: "
+         << latency.sojourn.p50() << " / " << latency.sojourn.p99() << " / " << latency.sojourn.p999() << endl;
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
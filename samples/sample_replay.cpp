@@ -0,0 +1,46 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "cluster.h"
+#include "replay.h"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    if (argc != 5 && argc != 6)
+    {
+        cerr << "Usage: " << argv[0] << " <arrivals> <capacity> <performance> <cycles> [seed]" << endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        TArrivalFile arrivals(argv[1]);
+        const size_t capacity = stoul(argv[2]);
+        const double performance = stod(argv[3]);
+        const long long cycles = stoll(argv[4]);
+        const uint64_t seed = argc == 6 ? stoull(argv[5]) : 0;
+
+        TCluster cluster(capacity, 0.0, performance, TRandom<double>(0.0, 1.0, seed));
+        cluster.replay(arrivals, cycles);
+
+        const auto& stat = cluster.stats();
+        const auto& latency = cluster.latency();
+        cout << "arrivals replayed: " << arrivals.consumed() << " of " << arrivals.size() << endl;
+        cout << "total tasks: " << stat.total_tasks << endl;
+        cout << "rejection share: " << stat.rejection_share() << endl;
+        cout << "service cycles: " << stat.service_cycles() << endl;
+        cout << "idle share: " << stat.idle_share() << endl;
+        cout << "sojourn p50 / p99 / p999: " << latency.sojourn.p50() << " / " << latency.sojourn.p99()
+             << " / " << latency.sojourn.p999() << endl;
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
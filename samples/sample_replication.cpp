@@ -0,0 +1,56 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "replication.h"
+
+using namespace std;
+
+static void print(const char* title, const TEstimate& estimate, double scale = 1.0)
+{
+    cout << title << (scale * estimate.mean) << " ± " << (scale * estimate.half_width) << endl;
+}
+
+int main()
+{
+    setlocale(LC_ALL, "Russian");
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+
+    /* -------------------------------------------- */
+    int capacity;
+    cout << "Мощность кластера (максимальное количество заданий): ";
+    cin >> capacity;
+
+    double intensity;
+    cout << "Интенсивность потока заданий: ";
+    cin >> intensity;
+
+    double performance;
+    cout << "Производительность кластера: ";
+    cin >> performance;
+
+    long long T;
+    cout << "Количество тактов: ";
+    cin >> T;
+
+    size_t replications;
+    cout << "Количество повторений эксперимента: ";
+    cin >> replications;
+
+    uint64_t seed;
+    cout << "Начальное значение генератора: ";
+    cin >> seed;
+
+    cout << endl;
+    /* -------------------------------------------- */
+
+    TReplicationRunner<> runner(capacity, intensity, performance, T);
+    const auto summary = TReplicationRunner<>::summarize(runner.run(replications, seed));
+
+    cout << "Доверительные интервалы (95%) по " << summary.replications << " повторениям" << endl;
+    print("Количество поступивших в систему заданий: ", summary.total_tasks);
+    print("Количество отказов в обслуживании из-за переполнения очереди, %: ", summary.rejection_share, 100);
+    print("Среднее количество тактов выполнения задания: ", summary.service_cycles);
+    print("Количество тактов простоя процессора из-за отсутствия заданий, %: ", summary.idle_share, 100);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "sweep.h"
+
+using namespace std;
+
+static int usage(const char* program)
+{
+    cerr << "Usage: " << program << " <config> [--json] [--analytic] [--threads N] [--seed S] [--output FILE]" << endl;
+    return EXIT_FAILURE;
+}
+
+// The whole argument as a number up to limit, std::invalid_argument or std::out_of_range otherwise
+static unsigned long long parse_number(const char* text, unsigned long long limit)
+{
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long value = strtoull(text, &end, 10);
+    // strtoull() also takes leading spaces and wraps a negative number around
+    if (!isdigit(static_cast<unsigned char>(text[0])) || *end)
+    {
+        throw invalid_argument(string("Bad number '") + text + "'");
+    }
+    if (errno == ERANGE || value > limit)
+    {
+        throw out_of_range(string("Number '") + text + "' is too large");
+    }
+    return value;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+        return usage(argv[0]);
+
+    bool json = false;
+    bool analytic = false;
+    unsigned threads = 0;
+    uint64_t seed = 0;
+    const char* output = nullptr;
+
+    try
+    {
+        for (int i = 2; i < argc; i++)
+        {
+            if (!strcmp(argv[i], "--json"))
+                json = true;
+            else if (!strcmp(argv[i], "--analytic"))
+                analytic = true;
+            else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+                threads = static_cast<unsigned>(parse_number(argv[++i], numeric_limits<unsigned>::max()));
+            else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+                seed = parse_number(argv[++i], numeric_limits<uint64_t>::max());
+            else if (!strcmp(argv[i], "--output") && i + 1 < argc)
+                output = argv[++i];
+            else
+                return usage(argv[0]);
+        }
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return usage(argv[0]);
+    }
+
+    ifstream config(argv[1]);
+    if (!config)
+    {
+        cerr << "Cannot open " << argv[1] << endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        const TSweep sweep = TSweep::parse(config);
+        const auto results = analytic ? sweep.solve() : sweep.run(seed, threads);
+
+        ofstream file;
+        if (output)
+        {
+            file.open(output);
+            if (!file)
+            {
+                cerr << "Cannot write " << output << endl;
+                return EXIT_FAILURE;
+            }
+        }
+        ostream& out = output ? file : cout;
+
+        if (json)
+            TSweep::write_json(out, results);
+        else
+            TSweep::write_csv(out, results);
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "trace.h"
+
+using namespace std;
+
+static int usage(const char* program)
+{
+    cerr << "Usage: " << program << " <trace> [--csv]" << endl;
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+        return usage(argv[0]);
+
+    bool csv = false;
+    if (argc == 3)
+    {
+        if (strcmp(argv[2], "--csv"))
+            return usage(argv[0]);
+        csv = true;
+    }
+
+    try
+    {
+        TTraceReader reader(argv[1]);
+        TTraceRecord record;
+
+        if (csv)
+        {
+            cout << "event,cycle,value\n";
+            while (reader.next(record))
+                cout << to_string(record.event) << ',' << record.cycle << ',' << record.value << '\n';
+            return EXIT_SUCCESS;
+        }
+
+        long long counts[5] = { 0, 0, 0, 0, 0 };
+        long long idle = 0, first = 0, last = 0;
+        for (bool any = false; reader.next(record); any = true)
+        {
+            if (!any)
+                first = record.cycle;
+            counts[static_cast<int>(record.event)]++;
+            if (record.event == TTraceEvent::Idle)
+            {
+                idle += record.value;
+                last = record.cycle + record.value - 1;
+            }
+            else
+            {
+                last = record.cycle;
+            }
+        }
+
+        const long long arrivals = counts[static_cast<int>(TTraceEvent::Arrival)];
+        const long long rejects = counts[static_cast<int>(TTraceEvent::Reject)];
+        cout << "cycles: " << first << " - " << last << endl;
+        for (int event = 0; event < 5; event++)
+            cout << to_string(static_cast<TTraceEvent>(event)) << " records: " << counts[event] << endl;
+        cout << "idle cycles: " << idle << endl;
+        if (arrivals + rejects)
+            cout << "rejection share: " << static_cast<double>(rejects) / (arrivals + rejects) << endl;
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+#include "chain.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // Transition probabilities between the two states (idle, busy) of a pair of queue levels
+    struct TBlock {
+        double at[2][2] = { { 0.0, 0.0 }, { 0.0, 0.0 } };
+
+        TBlock operator*(const TBlock& other) const noexcept
+        {
+            TBlock product;
+            for (int i = 0; i < 2; i++)
+                for (int j = 0; j < 2; j++)
+                    product.at[i][j] = at[i][0] * other.at[0][j] + at[i][1] * other.at[1][j];
+            return product;
+        }
+
+        TBlock operator+(const TBlock& other) const noexcept
+        {
+            TBlock sum;
+            for (int i = 0; i < 2; i++)
+                for (int j = 0; j < 2; j++)
+                    sum.at[i][j] = at[i][j] + other.at[i][j];
+            return sum;
+        }
+
+        bool is_zero() const noexcept
+        {
+            return at[0][0] == 0.0 && at[0][1] == 0.0 && at[1][0] == 0.0 && at[1][1] == 0.0;
+        }
+
+        // I - this
+        TBlock complement() const noexcept
+        {
+            TBlock result;
+            for (int i = 0; i < 2; i++)
+                for (int j = 0; j < 2; j++)
+                    result.at[i][j] = (i == j ? 1.0 : 0.0) - at[i][j];
+            return result;
+        }
+
+        TBlock inverse() const
+        {
+            const double det = at[0][0] * at[1][1] - at[0][1] * at[1][0];
+            if (det == 0.0)
+                throw std::domain_error("Cluster chain has no unique stationary distribution");
+
+            TBlock result;
+            result.at[0][0] = at[1][1] / det;
+            result.at[0][1] = -at[0][1] / det;
+            result.at[1][0] = -at[1][0] / det;
+            result.at[1][1] = at[0][0] / det;
+            return result;
+        }
+    };
+
+    struct TLevel {
+        double at[2] = { 0.0, 0.0 };
+
+        TLevel operator*(const TBlock& block) const noexcept
+        {
+            TLevel product;
+            for (int j = 0; j < 2; j++)
+                product.at[j] = at[0] * block.at[0][j] + at[1] * block.at[1][j];
+            return product;
+        }
+    };
+
+    bool valid_probability(double value) noexcept
+    {
+        return value >= 0.0 && value <= 1.0;
+    }
+}
+
+TClusterChain::TClusterChain(size_t capacity, double intensity, double performance)
+        : capacity(capacity)
+        , intensity(valid_probability(intensity)
+                    ? intensity
+                    : throw std::invalid_argument("Intensity should be within [0, 1]"))
+        , performance(valid_probability(performance)
+                      ? performance
+                      : throw std::invalid_argument("Performance should be within [0, 1]"))
+{
+    solve();
+}
+
+size_t TClusterChain::state(bool busy, size_t queued) noexcept
+{
+    return 2 * queued + (busy ? 1 : 0);
+}
+
+void TClusterChain::solve()
+{
+    const size_t levels = capacity + 1;
+
+    stationary.assign(2 * levels, 0.0);
+
+    if (intensity == 1.0 && performance == 1.0)
+    {
+        // Each task arrives and completes within one cycle, so every idle state
+        // is absorbing and the cluster never leaves the one it starts in
+        stationary[state(false, 0)] = 1.0;
+        return;
+    }
+
+    if (performance == 0.0)
+    {
+        // No task ever completes: the first one to get in keeps the processor
+        // busy for good and the queue fills up behind it
+        const bool stuck = intensity > 0.0 && capacity > 0;
+        stationary[stuck ? state(true, capacity) : state(false, 0)] = 1.0;
+        return;
+    }
+
+    // down[q], same[q] and up[q] lead from queue level q to q - 1, q and q + 1
+    std::vector<TBlock> down(levels), same(levels), up(levels);
+
+    for (size_t queued = 0; queued < levels; queued++)
+    {
+        for (int busy = 0; busy < 2; busy++)
+        {
+            // One cycle exactly as generate_tasks() and perform_cycle() play it
+            for (int arrived = 0; arrived < 2; arrived++)
+            {
+                const double arrival = arrived ? intensity : 1.0 - intensity;
+                if (arrival == 0.0)
+                    continue;
+
+                size_t next = queued + (arrived && queued < capacity ? 1 : 0);
+                bool working = busy;
+                if (!working && next > 0)
+                {
+                    working = true;
+                    next--;
+                }
+
+                TBlock& block = next < queued ? down[queued] : next > queued ? up[queued] : same[queued];
+                if (working)
+                {
+                    block.at[busy][0] += arrival * performance;
+                    block.at[busy][1] += arrival * (1.0 - performance);
+                }
+                else
+                {
+                    block.at[busy][0] += arrival;
+                }
+            }
+        }
+    }
+
+    // With a task arriving every cycle the queue never drops below the highest level
+    // it cannot leave downwards, so the levels under that one end up empty
+    size_t floor = capacity;
+    while (floor > 0 && !down[floor].is_zero())
+        floor--;
+
+    // Linear level reduction: rate[q] carries the level q - 1 distribution over to level q.
+    // The chain is level-skip-free, so the top level folds into the one below it and so on.
+    std::vector<TBlock> rate(levels);
+    TBlock folded = same[capacity];
+    for (size_t queued = capacity; queued > floor; queued--)
+    {
+        rate[queued] = up[queued - 1] * folded.complement().inverse();
+        folded = same[queued - 1] + rate[queued] * down[queued];
+    }
+
+    // The bottom level alone is a singular system, any of its two columns gives the solution
+    const TBlock bottom = folded.complement();
+    TLevel level;
+    if (std::fabs(bottom.at[0][0]) + std::fabs(bottom.at[1][0]) > 0.0)
+    {
+        level.at[0] = std::fabs(bottom.at[1][0]);
+        level.at[1] = std::fabs(bottom.at[0][0]);
+    }
+    else
+    {
+        level.at[0] = std::fabs(bottom.at[1][1]);
+        level.at[1] = std::fabs(bottom.at[0][1]);
+    }
+
+    // Under overload the mass grows geometrically with the queue, so the
+    // unnormalised levels are scaled down before they can overflow
+    const double limit = 1e200;
+    for (size_t queued = floor; queued < levels; queued++)
+    {
+        if (queued > floor)
+            level = level * rate[queued];
+
+        const double mass = level.at[0] + level.at[1];
+        if (mass > limit)
+        {
+            for (size_t i = 0; i < 2 * queued; i++)
+                stationary[i] /= mass;
+            level.at[0] /= mass;
+            level.at[1] /= mass;
+        }
+
+        stationary[state(false, queued)] = level.at[0];
+        stationary[state(true, queued)] = level.at[1];
+    }
+
+    double sum = 0.0;
+    for (double value : stationary)
+        sum += value;
+    for (double& value : stationary)
+        value /= sum;
+}
+
+double TClusterChain::probability(bool busy, size_t queued) const
+{
+    if (queued > capacity)
+        throw std::out_of_range("Queue length is out of range");
+
+    return stationary[state(busy, queued)];
+}
+
+double TClusterChain::rejection_share() const noexcept
+{
+    // Arrivals are independent of the state, so they see the stationary distribution
+    return intensity > 0.0 ? stationary[state(false, capacity)] + stationary[state(true, capacity)] : 0.0;
+}
+
+double TClusterChain::idle_share() const noexcept
+{
+    // Only an empty idle cluster that gets no task stays idle for a whole cycle.
+    // Without a queue every task is rejected, so it stays idle regardless.
+    return stationary[state(false, 0)] * (capacity > 0 ? 1.0 - intensity : 1.0);
+}
+
+double TClusterChain::completion_rate() const noexcept
+{
+    return (1.0 - idle_share()) * performance;
+}
+
+double TClusterChain::service_cycles() const noexcept
+{
+    const double rate = completion_rate();
+    return rate > 0.0 ? (1.0 - idle_share()) / rate : 0.0;
+}
+
+TPerfStat TClusterChain::expected(long long cycles) const noexcept
+{
+    const double span = static_cast<double>(cycles);
+
+    TPerfStat stat;
+    stat.cycles = cycles;
+    stat.total_tasks = std::llround(intensity * span);
+    stat.rejected_tasks = std::llround(intensity * rejection_share() * span);
+    stat.completed_tasks = std::llround(completion_rate() * span);
+    stat.idle_cycles = std::llround(idle_share() * span);
+    return stat;
+}
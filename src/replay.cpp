@@ -0,0 +1,182 @@
+#include "replay.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Mapping offsets have to be multiples of this
+    size_t map_granularity()
+    {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwAllocationGranularity;
+#else
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+}
+
+TArrivalFile::TArrivalFile(const std::string& path, size_t window)
+        : records(0)
+        , view(nullptr)
+        , viewSize(0)
+        , first(0)
+        , last(0)
+        , data(nullptr)
+        , position(0)
+        , current(0)
+{
+    const size_t granularity = map_granularity();
+    // At least two granules, so a window always holds the record it was mapped for
+    this->window = std::max(window / granularity, size_t(2)) * granularity;
+
+    uint64_t bytes;
+#ifdef _WIN32
+    mapping = nullptr;
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER size;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size))
+    {
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        throw std::runtime_error("Cannot open arrival file " + path);
+    }
+    bytes = static_cast<uint64_t>(size.QuadPart);
+#else
+    file = ::open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (file < 0 || fstat(file, &info) != 0)
+    {
+        if (file >= 0)
+            ::close(file);
+        throw std::runtime_error("Cannot open arrival file " + path);
+    }
+    bytes = static_cast<uint64_t>(info.st_size);
+#endif
+
+    records = bytes / 8;
+    if (bytes % 8)
+    {
+        release();
+        throw std::runtime_error(path + " is not an arrival file: size is not a multiple of 8 bytes");
+    }
+
+#ifdef _WIN32
+    // Windows cannot map an empty file
+    if (records)
+    {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            release();
+            throw std::runtime_error("Cannot map arrival file " + path);
+        }
+    }
+#endif
+
+    try
+    {
+        load();
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+}
+
+TArrivalFile::~TArrivalFile()
+{
+    release();
+}
+
+void TArrivalFile::release() noexcept
+{
+    unmap();
+#ifdef _WIN32
+    if (mapping)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+#else
+    if (file >= 0)
+        ::close(file);
+    file = -1;
+#endif
+}
+
+void TArrivalFile::map(uint64_t record)
+{
+    unmap();
+
+    const uint64_t offset = record * 8;
+    const uint64_t aligned = offset - offset % map_granularity();
+    const size_t length = static_cast<size_t>(std::min<uint64_t>(window, records * 8 - aligned));
+
+#ifdef _WIN32
+    void* address = MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(aligned >> 32),
+                                  static_cast<DWORD>(aligned), length);
+    if (!address)
+        throw std::runtime_error("Cannot map arrival file window");
+#else
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, static_cast<off_t>(aligned));
+    if (address == MAP_FAILED)
+        throw std::runtime_error("Cannot map arrival file window");
+    madvise(address, length, MADV_SEQUENTIAL);
+#endif
+
+    view = static_cast<const unsigned char*>(address);
+    viewSize = length;
+    first = record;
+    last = (aligned + length) / 8;
+    data = view + (offset - aligned);
+}
+
+void TArrivalFile::unmap() noexcept
+{
+    if (!view)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(view);
+#else
+    munmap(const_cast<unsigned char*>(view), viewSize);
+#endif
+    view = nullptr;
+    data = nullptr;
+    first = last = 0;
+}
+
+void TArrivalFile::load()
+{
+    if (position == records)
+    {
+        unmap();
+        current = Never;
+        return;
+    }
+
+    if (position < first || position >= last)
+        map(position);
+    accept(decode(data + (position - first) * 8));
+}
+
+void TArrivalFile::rewind()
+{
+    position = 0;
+    current = 0;
+    load();
+}
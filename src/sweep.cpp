@@ -0,0 +1,215 @@
+#include "sweep.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "arraylist.h"
+#include "chain.h"
+#include "random.h"
+
+namespace
+{
+    template<typename T>
+    std::vector<T> parse_values(const std::string& field, size_t line)
+    {
+        std::vector<T> values;
+        std::istringstream items(field);
+        std::string item;
+        while (std::getline(items, item, ','))
+        {
+            std::istringstream parser(item);
+            // Unsigned extraction would wrap "-1" around instead of failing
+            const bool negative = std::is_unsigned<T>::value && (parser >> std::ws).peek() == '-';
+            T value;
+            if (negative || !(parser >> value) || !(parser >> std::ws).eof())
+            {
+                throw std::invalid_argument("Sweep config line " + std::to_string(line) + ": bad value '" + item + "'");
+            }
+            values.push_back(value);
+        }
+        if (values.empty())
+        {
+            throw std::invalid_argument("Sweep config line " + std::to_string(line) + ": empty field");
+        }
+        return values;
+    }
+
+    // Work queue of one worker: the owner takes from the front, thieves from the back
+    struct TWorkQueue {
+        std::mutex guard;
+        TArrayList<size_t> points;
+
+        bool take_front(size_t& point)
+        {
+            std::lock_guard<std::mutex> lock(guard);
+            if (points.empty())
+                return false;
+            point = points.front();
+            points.pop_front();
+            return true;
+        }
+
+        bool take_back(size_t& point)
+        {
+            std::lock_guard<std::mutex> lock(guard);
+            if (points.empty())
+                return false;
+            point = points.back();
+            points.remove(points.size() - 1);
+            return true;
+        }
+    };
+}
+
+TSweep TSweep::parse(std::istream& config)
+{
+    TSweep sweep;
+    std::string text;
+    for (size_t line = 1; std::getline(config, text); line++)
+    {
+        text = text.substr(0, text.find('#'));
+
+        std::istringstream fields(text);
+        std::string capacity, intensity, performance, cycles, extra;
+        if (!(fields >> capacity))
+            continue;
+        if (!(fields >> intensity >> performance >> cycles) || (fields >> extra))
+        {
+            throw std::invalid_argument("Sweep config line " + std::to_string(line)
+                                        + ": expected capacity intensity performance cycles");
+        }
+
+        for (size_t c : parse_values<size_t>(capacity, line))
+            for (double i : parse_values<double>(intensity, line))
+                for (double p : parse_values<double>(performance, line))
+                    for (long long t : parse_values<long long>(cycles, line))
+                        sweep.add({ c, i, p, t });
+    }
+    return sweep;
+}
+
+void TSweep::add(const TSweepPoint& point)
+{
+    points.push_back(point);
+}
+
+const std::vector<TSweepPoint>& TSweep::get_points() const noexcept
+{
+    return points;
+}
+
+std::vector<TSweepResult> TSweep::run(uint64_t seed, unsigned threads) const
+{
+    const size_t count = points.size();
+
+    std::vector<TRandom<double>> streams;
+    streams.reserve(count);
+
+    TRandom<double> master(0.0, 1.0, seed);
+    for (size_t i = 0; i < count; i++)
+    {
+        streams.push_back(master);
+        master.jump();
+    }
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(count, 1)));
+
+    // Deal the points longest first, so every worker starts with the heavy ones
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+        return points[lhs].cycles > points[rhs].cycles;
+    });
+
+    std::vector<TWorkQueue> queues(threads);
+    for (size_t i = 0; i < count; i++)
+        queues[i % threads].points.push_back(order[i]);
+
+    std::vector<TSweepResult> results(count);
+    auto worker = [&](unsigned self) {
+        size_t i;
+        for (;;)
+        {
+            bool found = queues[self].take_front(i);
+            for (unsigned victim = 1; !found && victim < threads; victim++)
+                found = queues[(self + victim) % threads].take_back(i);
+            if (!found)
+                return;
+
+            const TSweepPoint& point = points[i];
+            TCluster cluster(point.capacity, point.intensity, point.performance, streams[i]);
+            cluster.simulate(point.cycles);
+            results[i] = { point, cluster.stats() };
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& thread : pool)
+        thread.join();
+
+    return results;
+}
+
+std::vector<TSweepResult> TSweep::solve() const
+{
+    std::vector<TSweepResult> results;
+    results.reserve(points.size());
+    for (const TSweepPoint& point : points)
+    {
+        const TClusterChain chain(point.capacity, point.intensity, point.performance);
+        results.push_back({ point, chain.expected(point.cycles) });
+    }
+    return results;
+}
+
+void TSweep::write_csv(std::ostream& out, const std::vector<TSweepResult>& results)
+{
+    out << "capacity,intensity,performance,cycles,total_tasks,completed_tasks,rejected_tasks,idle_cycles,"
+           "rejection_share,service_cycles,idle_share\n";
+    for (const TSweepResult& result : results)
+    {
+        const TSweepPoint& point = result.point;
+        const TPerfStat& stat = result.stat;
+        out << point.capacity << ',' << point.intensity << ',' << point.performance << ',' << point.cycles << ','
+            << stat.total_tasks << ',' << stat.completed_tasks << ',' << stat.rejected_tasks << ','
+            << stat.idle_cycles << ',' << stat.rejection_share() << ',' << stat.service_cycles() << ','
+            << stat.idle_share() << '\n';
+    }
+}
+
+void TSweep::write_json(std::ostream& out, const std::vector<TSweepResult>& results)
+{
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const TSweepPoint& point = results[i].point;
+        const TPerfStat& stat = results[i].stat;
+        out << "  {\"capacity\": " << point.capacity
+            << ", \"intensity\": " << point.intensity
+            << ", \"performance\": " << point.performance
+            << ", \"cycles\": " << point.cycles
+            << ", \"total_tasks\": " << stat.total_tasks
+            << ", \"completed_tasks\": " << stat.completed_tasks
+            << ", \"rejected_tasks\": " << stat.rejected_tasks
+            << ", \"idle_cycles\": " << stat.idle_cycles
+            << ", \"rejection_share\": " << stat.rejection_share()
+            << ", \"service_cycles\": " << stat.service_cycles()
+            << ", \"idle_share\": " << stat.idle_share()
+            << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
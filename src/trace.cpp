@@ -0,0 +1,191 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+const char TTraceWriter::Magic[4] = { 'C', 'T', 'R', 'C' };
+
+TTraceWriter::TTraceWriter(const std::string& path, size_t bufferSize)
+        : file(path, std::ios::binary | std::ios::trunc)
+        , front(std::max(bufferSize, 4 * MaxRecordSize))
+        , used(0)
+        , back(front.size())
+        , backUsed(0)
+        , lastCycle(0)
+        , lastTask(0)
+        , idleFrom(0)
+        , idleCycles(0)
+        , pending(false)
+        , closing(false)
+        , failed(false)
+{
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open trace file " + path);
+    }
+
+    file.write(Magic, sizeof(Magic));
+    file.put(static_cast<char>(Version));
+
+    writer = std::thread(&TTraceWriter::write_loop, this);
+}
+
+TTraceWriter::~TTraceWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+void TTraceWriter::flush_idle()
+{
+    if (front.size() - used < MaxRecordSize)
+        submit();
+
+    put(TTraceEvent::Idle, idleFrom, static_cast<uint64_t>(idleCycles));
+    idleCycles = 0;
+}
+
+void TTraceWriter::submit()
+{
+    require_open();
+
+    std::unique_lock<std::mutex> lock(guard);
+    // The other buffer may still be on its way to the file
+    changed.wait(lock, [this] { return !pending; });
+
+    front.swap(back);
+    backUsed = used;
+    used = 0;
+    pending = true;
+    changed.notify_all();
+}
+
+void TTraceWriter::write_loop()
+{
+    std::unique_lock<std::mutex> lock(guard);
+    for (;;)
+    {
+        changed.wait(lock, [this] { return pending || closing; });
+        if (!pending)
+            return;
+
+        // Only this thread touches back while pending is set
+        lock.unlock();
+        file.write(back.data(), static_cast<std::streamsize>(backUsed));
+        const bool ok = static_cast<bool>(file);
+        lock.lock();
+
+        failed = failed || !ok;
+        pending = false;
+        changed.notify_all();
+    }
+}
+
+void TTraceWriter::close()
+{
+    if (!writer.joinable())
+        return;
+
+    if (idleCycles)
+        flush_idle();
+    submit();
+
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        closing = true;
+    }
+    changed.notify_all();
+    writer.join();
+
+    file.close();
+    if (failed || !file)
+    {
+        throw std::runtime_error("Cannot write trace file");
+    }
+}
+
+TTraceReader::TTraceReader(const std::string& path)
+        : file(path, std::ios::binary)
+        , lastCycle(0)
+        , lastTask(0)
+{
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open trace file " + path);
+    }
+
+    char magic[sizeof(TTraceWriter::Magic)];
+    const int version = file.read(magic, sizeof(magic)) ? file.get() : -1;
+    if (!file || !std::equal(magic, magic + sizeof(magic), TTraceWriter::Magic) || version != TTraceWriter::Version)
+    {
+        throw std::runtime_error(path + " is not a cluster trace");
+    }
+}
+
+bool TTraceReader::get_varint(uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const int byte = file.get();
+        if (byte == std::char_traits<char>::eof())
+            return false;
+
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool TTraceReader::next(TTraceRecord& record)
+{
+    const int tag = file.get();
+    if (tag == std::char_traits<char>::eof())
+        return false;
+
+    uint64_t cycle, value;
+    if (tag > static_cast<int>(TTraceEvent::Idle) || !get_varint(cycle) || !get_varint(value))
+    {
+        throw std::runtime_error("Trace is corrupted");
+    }
+
+    const auto unzigzag = [](uint64_t encoded) {
+        return static_cast<long long>(encoded >> 1) ^ -static_cast<long long>(encoded & 1);
+    };
+
+    record.event = static_cast<TTraceEvent>(tag);
+    record.cycle = lastCycle += unzigzag(cycle);
+    if (record.event == TTraceEvent::Idle)
+    {
+        record.value = static_cast<long long>(value);
+    }
+    else
+    {
+        record.value = lastTask += unzigzag(value);
+    }
+    return true;
+}
+
+const char* to_string(TTraceEvent event) noexcept
+{
+    switch (event)
+    {
+        case TTraceEvent::Arrival:
+            return "arrival";
+        case TTraceEvent::Reject:
+            return "reject";
+        case TTraceEvent::Start:
+            return "start";
+        case TTraceEvent::Complete:
+            return "complete";
+        case TTraceEvent::Idle:
+            return "idle";
+    }
+    return "unknown";
+}
@@ -0,0 +1,142 @@
+#include <gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "cluster.h"
+#include "replay.h"
+
+namespace
+{
+    const char* const ArrivalPath = "test_arrivals.bin";
+
+    void write_arrivals(const std::vector<unsigned long long>& cycles)
+    {
+        std::ofstream file(ArrivalPath, std::ios::binary | std::ios::trunc);
+        for (unsigned long long cycle : cycles)
+        {
+            for (int i = 0; i < 8; i++)
+                file.put(static_cast<char>(cycle >> (8 * i)));
+        }
+    }
+}
+
+TEST(TArrivalFile, reads_recorded_cycles)
+{
+    write_arrivals({ 1, 1, 5, 300 });
+    {
+        TArrivalFile arrivals(ArrivalPath);
+
+        ASSERT_EQ(4, arrivals.size());
+        EXPECT_EQ(1, arrivals.peek());
+        arrivals.pop();
+        arrivals.pop();
+        EXPECT_EQ(5, arrivals.peek());
+        arrivals.pop();
+        arrivals.pop();
+        EXPECT_EQ(TArrivalFile::Never, arrivals.peek());
+
+        arrivals.rewind();
+        EXPECT_EQ(1, arrivals.peek());
+    }
+    std::remove(ArrivalPath);
+}
+
+TEST(TArrivalFile, streams_through_many_windows)
+{
+    std::vector<unsigned long long> cycles;
+    for (unsigned long long i = 1; i <= 100000; i++)
+        cycles.push_back(i * 3);
+    write_arrivals(cycles);
+    {
+        // The window shrinks to two pages, so the file is remapped many times
+        TArrivalFile arrivals(ArrivalPath, 1);
+
+        long long count = 0, last = 0;
+        for (; arrivals.peek() != TArrivalFile::Never; arrivals.pop())
+        {
+            EXPECT_EQ(last + 3, arrivals.peek());
+            last = arrivals.peek();
+            count++;
+        }
+        EXPECT_EQ(100000, count);
+    }
+    std::remove(ArrivalPath);
+}
+
+TEST(TArrivalFile, rejects_malformed_files)
+{
+    EXPECT_THROW(TArrivalFile("no_such_arrivals.bin"), std::runtime_error);
+
+    {
+        std::ofstream file(ArrivalPath, std::ios::binary | std::ios::trunc);
+        file << "12345";
+    }
+    EXPECT_THROW(TArrivalFile arrivals(ArrivalPath), std::runtime_error);
+
+    write_arrivals({ 5, 3 });
+    {
+        TArrivalFile arrivals(ArrivalPath);
+        EXPECT_THROW(arrivals.pop(), std::runtime_error);
+    }
+    std::remove(ArrivalPath);
+}
+
+TEST(TArrivalFile, replay_follows_the_log)
+{
+    write_arrivals({ 1, 1, 1, 5 });
+    {
+        TArrivalFile arrivals(ArrivalPath);
+        TCluster cluster(1, 0.0, 1.0);
+        cluster.replay(arrivals, 10);
+
+        // Cycle 1 queues one task and rejects two, cycle 5 brings the last one
+        const auto& stat = cluster.stats();
+        EXPECT_EQ(10, stat.cycles);
+        EXPECT_EQ(4, stat.total_tasks);
+        EXPECT_EQ(2, stat.rejected_tasks);
+        EXPECT_EQ(2, stat.completed_tasks);
+        EXPECT_EQ(8, stat.idle_cycles);
+    }
+    std::remove(ArrivalPath);
+}
+
+TEST(TArrivalFile, replay_keeps_later_arrivals_for_next_call)
+{
+    write_arrivals({ 2, 8 });
+    {
+        TArrivalFile arrivals(ArrivalPath);
+        TCluster cluster(4, 0.0, 1.0);
+
+        cluster.replay(arrivals, 5);
+        EXPECT_EQ(1, cluster.stats().total_tasks);
+        EXPECT_EQ(8, arrivals.peek());
+
+        cluster.replay(arrivals, 5);
+        EXPECT_EQ(2, cluster.stats().total_tasks);
+        EXPECT_EQ(2, cluster.stats().completed_tasks);
+    }
+    std::remove(ArrivalPath);
+}
+
+TEST(TArrivalFile, replay_is_reproducible)
+{
+    std::vector<unsigned long long> cycles;
+    for (unsigned long long i = 1; i <= 20000; i++)
+        cycles.push_back(i + i / 3);
+    write_arrivals(cycles);
+    {
+        TCluster first(4, 0.0, 0.6, TRandom<double>(0.0, 1.0, 11));
+        TArrivalFile firstArrivals(ArrivalPath);
+        first.replay(firstArrivals, 30000);
+
+        TCluster second(4, 0.0, 0.6, TRandom<double>(0.0, 1.0, 11));
+        TArrivalFile secondArrivals(ArrivalPath, 1);
+        second.replay(secondArrivals, 30000);
+
+        EXPECT_EQ(20000, first.stats().total_tasks);
+        EXPECT_EQ(first.stats().completed_tasks, second.stats().completed_tasks);
+        EXPECT_EQ(first.stats().rejected_tasks, second.stats().rejected_tasks);
+        EXPECT_EQ(first.stats().idle_cycles, second.stats().idle_cycles);
+    }
+    std::remove(ArrivalPath);
+}
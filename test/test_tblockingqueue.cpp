@@ -0,0 +1,115 @@
+#include <gtest.h>
+#include "blockingqueue.h"
+#include "cqueue.h"
+#include "queue.h"
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(TBlockingQueue, wraps_queue_with_its_capacity)
+{
+    TBlockingQueue<TCircularQueue<int>> queue(3);
+
+    EXPECT_EQ(3, queue.max_size());
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.full());
+}
+
+TEST(TBlockingQueue, does_not_wait_when_it_does_not_have_to)
+{
+    TBlockingQueue<TCircularQueue<int>> queue(2);
+
+    queue.push_wait(1);
+    queue.push_wait(2);
+
+    EXPECT_TRUE(queue.full());
+    EXPECT_EQ(1, queue.poll_wait());
+    EXPECT_EQ(2, queue.poll_wait());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(TBlockingQueue, poll_wait_for_times_out_on_empty_queue)
+{
+    TBlockingQueue<TQueue<int>> queue(2);
+    int element = 7;
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.poll_wait_for(element, 20ms));
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    EXPECT_EQ(7, element);
+}
+
+TEST(TBlockingQueue, push_wait_for_times_out_on_full_queue)
+{
+    TBlockingQueue<TCircularQueue<int>> queue(1);
+    queue.push_wait(1);
+
+    EXPECT_FALSE(queue.push_wait_for(2, 20ms));
+    EXPECT_EQ(1, queue.size());
+    EXPECT_FALSE(queue.try_push(2));
+}
+
+TEST(TBlockingQueue, parked_consumer_is_woken_by_push)
+{
+    TBlockingQueue<TCircularQueue<int>> queue(1);
+
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(20ms);
+        queue.push_wait(5);
+    });
+
+    int element = 0;
+    EXPECT_TRUE(queue.poll_wait_for(element, 10s));
+    EXPECT_EQ(5, element);
+    producer.join();
+}
+
+TEST(TBlockingQueue, parked_producer_is_woken_by_poll)
+{
+    TBlockingQueue<TQueue<int>> queue(1);
+    queue.push_wait(1);
+
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(20ms);
+        EXPECT_EQ(1, queue.poll_wait());
+    });
+
+    EXPECT_TRUE(queue.push_wait_for(2, 10s));
+    consumer.join();
+    EXPECT_EQ(2, queue.poll_wait());
+}
+
+TEST(TBlockingQueue, keeps_order_between_threads)
+{
+    const int count = 20000;
+    TBlockingQueue<TCircularQueue<int>> queue(4);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < count; i++)
+            queue.push_wait(i);
+    });
+
+    bool ordered = true;
+    for (int i = 0; i < count; i++)
+        ordered &= queue.poll_wait() == i;
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(TBlockingQueue, can_hold_move_only_elements)
+{
+    TBlockingQueue<TBaseQueue<std::unique_ptr<int>, TArrayList>> queue(2);
+
+    queue.push_wait(std::make_unique<int>(1));
+    EXPECT_TRUE(queue.push_wait_for(std::make_unique<int>(2), 1ms));
+
+    EXPECT_EQ(1, *queue.poll_wait());
+    std::unique_ptr<int> element;
+    EXPECT_TRUE(queue.try_poll(element));
+    EXPECT_EQ(2, *element);
+}
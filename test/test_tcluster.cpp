@@ -0,0 +1,208 @@
+#include <gtest.h>
+#include "cluster.h"
+#include "scqueue.h"
+#include <random>
+
+namespace
+{
+    template<typename T>
+    using TCoreQueue = TStaticCircularQueue<T, 8>;
+}
+
+TEST(TCluster, can_create_cluster)
+{
+    EXPECT_NO_THROW(TCluster cluster(8, 0.5, 0.5));
+}
+
+TEST(TCluster, saturated_cluster_completes_task_every_cycle)
+{
+    TCluster cluster(4, 1.0, 1.0);
+    cluster.simulate(1000);
+
+    const auto& stat = cluster.stats();
+    EXPECT_EQ(1000, stat.cycles);
+    EXPECT_EQ(1000, stat.total_tasks);
+    EXPECT_EQ(1000, stat.completed_tasks);
+    EXPECT_EQ(0, stat.rejected_tasks);
+    EXPECT_EQ(0, stat.idle_cycles);
+}
+
+TEST(TCluster, cluster_without_tasks_stays_idle)
+{
+    TCluster cluster(4, 0.0, 0.5);
+    cluster.simulate(1000);
+
+    EXPECT_EQ(1000, cluster.stats().cycles);
+    EXPECT_EQ(1000, cluster.stats().idle_cycles);
+    EXPECT_EQ(0, cluster.stats().total_tasks);
+}
+
+TEST(TCluster, rejects_negative_cycle_count)
+{
+    TCluster cluster(4, 0.5, 0.5);
+    cluster.simulate(10);
+
+    EXPECT_THROW(cluster.simulate(-1), std::invalid_argument);
+    EXPECT_EQ(10, cluster.stats().cycles);
+}
+
+TEST(TCluster, event_simulation_matches_cycle_by_cycle_simulation)
+{
+    const long long cycles = 400000;
+
+    TCluster ticked(5, 0.3, 0.35, TRandom<double>(0.0, 1.0, 3));
+    for (long long i = 0; i < cycles; i++)
+    {
+        ticked.generate_tasks();
+        ticked.perform_cycle();
+    }
+
+    TCluster jumped(5, 0.3, 0.35, TRandom<double>(0.0, 1.0, 4));
+    jumped.simulate(cycles);
+
+    EXPECT_EQ(cycles, jumped.stats().cycles);
+    EXPECT_NEAR(ticked.stats().idle_share(), jumped.stats().idle_share(), 0.01);
+    EXPECT_NEAR(ticked.stats().rejection_share(), jumped.stats().rejection_share(), 0.01);
+    EXPECT_NEAR(ticked.stats().service_cycles(), jumped.stats().service_cycles(), 0.1);
+}
+
+TEST(TCluster, cluster_without_queue_rejects_every_task)
+{
+    TCluster ticked(0, 0.5, 0.5, TRandom<double>(0.0, 1.0, 1));
+    for (int i = 0; i < 100000; i++)
+    {
+        ticked.generate_tasks();
+        ticked.perform_cycle();
+    }
+
+    TCluster jumped(0, 0.5, 0.5, TRandom<double>(0.0, 1.0, 1));
+    jumped.simulate(100000);
+
+    TCountingCluster counting(0, 0.5, 0.5, TRandom<double>(0.0, 1.0, 1));
+    counting.simulate(100000);
+
+    for (const TPerfStat* stat : { &ticked.stats(), &jumped.stats(), &counting.stats() })
+    {
+        EXPECT_EQ(0, stat->completed_tasks);
+        EXPECT_EQ(100000, stat->idle_cycles);
+        EXPECT_EQ(stat->total_tasks, stat->rejected_tasks);
+    }
+}
+
+TEST(TCluster, counting_cluster_completes_task_every_cycle_when_saturated)
+{
+    TCountingCluster cluster(4, 1.0, 1.0);
+    cluster.simulate(1000);
+
+    EXPECT_EQ(1000, cluster.stats().completed_tasks);
+    EXPECT_EQ(0, cluster.stats().idle_cycles);
+}
+
+TEST(TCluster, counting_cluster_matches_detailed_cluster)
+{
+    const long long cycles = 400000;
+
+    TCluster detailed(3, 0.4, 0.3, TRandom<double>(0.0, 1.0, 5));
+    detailed.simulate(cycles);
+
+    TCountingCluster counting(3, 0.4, 0.3, TRandom<double>(0.0, 1.0, 6));
+    counting.simulate(cycles);
+
+    EXPECT_EQ(detailed.get_capacity(), counting.get_capacity());
+    EXPECT_NEAR(detailed.stats().idle_share(), counting.stats().idle_share(), 0.01);
+    EXPECT_NEAR(detailed.stats().rejection_share(), counting.stats().rejection_share(), 0.01);
+    EXPECT_NEAR(detailed.stats().service_cycles(), counting.stats().service_cycles(), 0.1);
+}
+
+TEST(TCluster, mersenne_twister_cluster_matches_default_engine)
+{
+    TCluster xoshiro(5, 0.3, 0.35, TRandom<double>(0.0, 1.0, 10));
+    TBasicCluster<TQueue, std::mt19937> twister(5, 0.3, 0.35, TRandom<double, std::mt19937>(0.0, 1.0, 11));
+    xoshiro.simulate(200000);
+    twister.simulate(200000);
+
+    EXPECT_NEAR(xoshiro.stats().idle_share(), twister.stats().idle_share(), 0.02);
+    EXPECT_NEAR(xoshiro.stats().rejection_share(), twister.stats().rejection_share(), 0.02);
+    EXPECT_NEAR(xoshiro.stats().service_cycles(), twister.stats().service_cycles(), 0.2);
+}
+
+TEST(TCluster, seeded_clusters_are_reproducible)
+{
+    TCluster first(4, 0.4, 0.3, TRandom<double>(0.0, 1.0, 42));
+    TCluster second(4, 0.4, 0.3, TRandom<double>(0.0, 1.0, 42));
+    first.simulate(10000);
+    second.simulate(10000);
+
+    EXPECT_EQ(first.stats().completed_tasks, second.stats().completed_tasks);
+    EXPECT_EQ(first.stats().rejected_tasks, second.stats().rejected_tasks);
+    EXPECT_EQ(first.stats().idle_cycles, second.stats().idle_cycles);
+}
+
+TEST(TCluster, cluster_on_static_queue_matches_cluster_on_heap_queue)
+{
+    TCluster heap(4, 0.4, 0.3, TRandom<double>(0.0, 1.0, 42));
+    TBasicCluster<TCoreQueue> inline_queue(4, 0.4, 0.3, TRandom<double>(0.0, 1.0, 42));
+    heap.simulate(10000);
+    inline_queue.simulate(10000);
+
+    EXPECT_EQ(heap.get_capacity(), inline_queue.get_capacity());
+    EXPECT_EQ(heap.stats().completed_tasks, inline_queue.stats().completed_tasks);
+    EXPECT_EQ(heap.stats().rejected_tasks, inline_queue.stats().rejected_tasks);
+    EXPECT_EQ(heap.stats().idle_cycles, inline_queue.stats().idle_cycles);
+    EXPECT_EQ(heap.latency().sojourn.p99(), inline_queue.latency().sojourn.p99());
+}
+
+TEST(TCluster, saturated_cluster_serves_every_task_in_one_cycle)
+{
+    TCluster cluster(4, 1.0, 1.0);
+    cluster.simulate(1000);
+
+    const TLatencyStat& latency = cluster.latency();
+    EXPECT_EQ(1000, latency.sojourn.count());
+    EXPECT_EQ(0, latency.wait.max());
+    EXPECT_EQ(1, latency.service.p999());
+    EXPECT_EQ(1, latency.sojourn.p999());
+}
+
+TEST(TCluster, records_latency_of_every_completed_task)
+{
+    TCluster cluster(5, 0.3, 0.35, TRandom<double>(0.0, 1.0, 9));
+    cluster.simulate(400000);
+
+    const auto& stat = cluster.stats();
+    const TLatencyStat& latency = cluster.latency();
+    EXPECT_EQ(stat.completed_tasks, latency.sojourn.count());
+    EXPECT_NEAR(stat.service_cycles(), latency.service.mean(), 0.01);
+    EXPECT_NEAR(latency.wait.mean() + latency.service.mean(), latency.sojourn.mean(), 1e-9);
+    EXPECT_LE(latency.sojourn.p50(), latency.sojourn.p99());
+    EXPECT_LE(latency.sojourn.p99(), latency.sojourn.p999());
+}
+
+TEST(TCluster, cycle_by_cycle_latency_matches_event_simulation)
+{
+    const long long cycles = 400000;
+
+    TCluster ticked(5, 0.3, 0.35, TRandom<double>(0.0, 1.0, 7));
+    for (long long i = 0; i < cycles; i++)
+    {
+        ticked.generate_tasks();
+        ticked.perform_cycle();
+    }
+
+    TCluster jumped(5, 0.3, 0.35, TRandom<double>(0.0, 1.0, 8));
+    jumped.simulate(cycles);
+
+    EXPECT_NEAR(ticked.latency().wait.mean(), jumped.latency().wait.mean(), 0.5);
+    EXPECT_NEAR(ticked.latency().sojourn.mean(), jumped.latency().sojourn.mean(), 0.5);
+}
+
+TEST(TCluster, counting_cluster_does_not_track_latency)
+{
+    TCountingCluster cluster(4, 0.5, 0.5);
+    cluster.simulate(1000);
+
+    EXPECT_FALSE(TCountingCluster::TracksLatency);
+    // The histograms are not part of the cluster
+    EXPECT_LE(sizeof(TCountingCluster) + sizeof(TLatencyStat), sizeof(TCluster));
+    EXPECT_EQ(0, cluster.latency().sojourn.count());
+}
@@ -0,0 +1,136 @@
+#include <gtest.h>
+#include "chain.h"
+
+namespace
+{
+    TPerfStat ticked(size_t capacity, double intensity, double performance, long long cycles)
+    {
+        TCluster cluster(capacity, intensity, performance, TRandom<double>(0.0, 1.0, 3));
+        for (long long i = 0; i < cycles; i++)
+        {
+            cluster.generate_tasks();
+            cluster.perform_cycle();
+        }
+        return cluster.stats();
+    }
+}
+
+TEST(TClusterChain, can_create_chain)
+{
+    EXPECT_NO_THROW(TClusterChain chain(8, 0.5, 0.5));
+}
+
+TEST(TClusterChain, rejects_bad_parameters)
+{
+    EXPECT_THROW(TClusterChain(4, 1.5, 0.5), std::invalid_argument);
+    EXPECT_THROW(TClusterChain(4, 0.5, -0.1), std::invalid_argument);
+}
+
+TEST(TClusterChain, cluster_without_queue_rejects_every_task)
+{
+    const long long cycles = 100000;
+    const TClusterChain chain(0, 0.5, 0.5);
+    const TPerfStat stat = ticked(0, 0.5, 0.5, cycles);
+
+    EXPECT_NEAR(1.0, chain.rejection_share(), 1e-12);
+    EXPECT_NEAR(1.0, chain.idle_share(), 1e-12);
+    EXPECT_EQ(0.0, chain.completion_rate());
+    EXPECT_NEAR(chain.rejection_share(), stat.rejection_share(), 1e-12);
+    EXPECT_NEAR(chain.idle_share(), stat.idle_share(), 1e-12);
+}
+
+TEST(TClusterChain, stalled_processor_ends_up_rejecting_every_task)
+{
+    const long long cycles = 100000;
+    const TClusterChain chain(4, 0.5, 0.0);
+    const TPerfStat stat = ticked(4, 0.5, 0.0, cycles);
+
+    EXPECT_NEAR(1.0, chain.probability(true, 4), 1e-12);
+    EXPECT_NEAR(1.0, chain.rejection_share(), 1e-12);
+    EXPECT_NEAR(0.0, chain.idle_share(), 1e-12);
+    EXPECT_NEAR(chain.rejection_share(), stat.rejection_share(), 0.001);
+    EXPECT_NEAR(chain.idle_share(), stat.idle_share(), 0.001);
+    EXPECT_EQ(0, stat.completed_tasks);
+
+    const TClusterChain idle(4, 0.0, 0.0);
+    EXPECT_NEAR(1.0, idle.idle_share(), 1e-12);
+}
+
+TEST(TClusterChain, distribution_sums_to_one)
+{
+    const TClusterChain chain(6, 0.4, 0.3);
+
+    double sum = 0.0;
+    for (size_t queued = 0; queued <= 6; queued++)
+        sum += chain.probability(false, queued) + chain.probability(true, queued);
+
+    EXPECT_NEAR(1.0, sum, 1e-12);
+    EXPECT_THROW((void) chain.probability(false, 7), std::out_of_range);
+}
+
+TEST(TClusterChain, saturated_cluster_is_never_idle)
+{
+    const TClusterChain chain(4, 1.0, 1.0);
+
+    EXPECT_NEAR(0.0, chain.rejection_share(), 1e-12);
+    EXPECT_NEAR(0.0, chain.idle_share(), 1e-12);
+    EXPECT_NEAR(1.0, chain.service_cycles(), 1e-12);
+}
+
+TEST(TClusterChain, cluster_without_tasks_is_always_idle)
+{
+    const TClusterChain chain(4, 0.0, 0.5);
+
+    EXPECT_NEAR(1.0, chain.idle_share(), 1e-12);
+    EXPECT_EQ(0.0, chain.rejection_share());
+}
+
+TEST(TClusterChain, overloaded_large_cluster_rejects_excess_work)
+{
+    // The processor never rests, so it completes 0.3 of the 0.9 tasks arriving per cycle
+    const TClusterChain chain(5000, 0.9, 0.3);
+
+    EXPECT_NEAR(0.0, chain.idle_share(), 1e-9);
+    EXPECT_NEAR(2.0 / 3.0, chain.rejection_share(), 1e-9);
+}
+
+TEST(TClusterChain, matches_simulation)
+{
+    const long long cycles = 400000;
+    const TClusterChain chain(5, 0.3, 0.35);
+    const TPerfStat stat = ticked(5, 0.3, 0.35, cycles);
+
+    EXPECT_NEAR(chain.idle_share(), stat.idle_share(), 0.01);
+    EXPECT_NEAR(chain.rejection_share(), stat.rejection_share(), 0.01);
+    EXPECT_NEAR(chain.service_cycles(), stat.service_cycles(), 0.1);
+}
+
+TEST(TClusterChain, solves_cluster_receiving_task_every_cycle)
+{
+    const TClusterChain chain(3, 1.0, 0.5);
+
+    EXPECT_NEAR(0.5, chain.rejection_share(), 1e-9);
+    EXPECT_NEAR(0.0, chain.idle_share(), 1e-9);
+    EXPECT_NEAR(0.0, chain.probability(false, 0), 1e-12);
+}
+
+TEST(TClusterChain, matches_simulation_of_small_queue)
+{
+    const long long cycles = 400000;
+    const TClusterChain chain(1, 0.6, 0.5);
+    const TPerfStat stat = ticked(1, 0.6, 0.5, cycles);
+
+    EXPECT_NEAR(chain.idle_share(), stat.idle_share(), 0.01);
+    EXPECT_NEAR(chain.rejection_share(), stat.rejection_share(), 0.01);
+}
+
+TEST(TClusterChain, expected_counters_follow_shares)
+{
+    const TClusterChain chain(5, 0.3, 0.35);
+    const TPerfStat stat = chain.expected(1000000);
+
+    EXPECT_EQ(1000000, stat.cycles);
+    EXPECT_EQ(300000, stat.total_tasks);
+    EXPECT_NEAR(chain.rejection_share(), stat.rejection_share(), 1e-5);
+    EXPECT_NEAR(chain.idle_share(), stat.idle_share(), 1e-5);
+}
@@ -1,5 +1,7 @@
 #include <gtest.h>
 #include "cqueue.h"
+#include <memory>
+#include <vector>
 
 TEST(TCircularQueue, can_create_queue)
 {
@@ -62,4 +64,261 @@ TEST(TCircularQueue, elements_placed_densely)
     EXPECT_EQ(5, queue.poll());
     EXPECT_EQ(6, queue.poll());
     EXPECT_EQ(7, queue.poll());
-}
\ No newline at end of file
+}
+
+TEST(TCircularQueue, pop_element_retrieves_last_element)
+{
+    TCircularQueue<int> queue(3);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    EXPECT_EQ(3, queue.top());
+    EXPECT_EQ(3, queue.pop_element());
+    EXPECT_EQ(2, queue.pop_element());
+    EXPECT_EQ(1, queue.size());
+}
+
+TEST(TCircularQueue, can_hold_move_only_elements)
+{
+    TCircularQueue<std::unique_ptr<int>> queue(2);
+    queue.push(std::unique_ptr<int>(new int(1)));
+    queue.emplace(new int(2));
+
+    EXPECT_EQ(1, *queue.poll());
+    queue.emplace(new int(3));
+
+    EXPECT_EQ(2, *queue.poll());
+    EXPECT_EQ(3, *queue.poll());
+}
+
+namespace
+{
+    struct Counted
+    {
+        static int alive;
+        int value;
+
+        explicit Counted(int value) : value(value) { alive++; }
+        Counted(const Counted& src) : value(src.value) { alive++; }
+        ~Counted() { alive--; }
+    };
+
+    int Counted::alive = 0;
+}
+
+TEST(TCircularQueue, constructs_only_queued_elements)
+{
+    {
+        TCircularQueue<Counted> queue(16);
+        EXPECT_EQ(0, Counted::alive);
+
+        queue.emplace(1);
+        queue.emplace(2);
+        EXPECT_EQ(2, Counted::alive);
+
+        EXPECT_EQ(1, queue.poll().value);
+        EXPECT_EQ(1, Counted::alive);
+
+        TCircularQueue<Counted> copy(queue);
+        EXPECT_EQ(2, copy.peek().value);
+        EXPECT_EQ(2, Counted::alive);
+    }
+    EXPECT_EQ(0, Counted::alive);
+}
+
+TEST(TCircularQueue, try_push_and_try_poll_wrap_around)
+{
+    TCircularQueue<int> queue(3);
+
+    for (int round = 0; round < 5; round++)
+    {
+        EXPECT_TRUE(queue.try_push(round));
+        EXPECT_TRUE(queue.try_push(round + 10));
+        EXPECT_TRUE(queue.try_push(round + 20));
+        EXPECT_FALSE(queue.try_push(round + 30));
+
+        int element = -1;
+        EXPECT_TRUE(queue.try_poll(element));
+        EXPECT_EQ(round, element);
+        EXPECT_TRUE(queue.try_poll(element));
+        EXPECT_TRUE(queue.try_poll(element));
+        EXPECT_EQ(round + 20, element);
+        EXPECT_FALSE(queue.try_poll(element));
+        EXPECT_EQ(round + 20, element);
+    }
+}
+
+TEST(TCircularQueue, try_pop_takes_last_element)
+{
+    TCircularQueue<int> queue(4);
+    queue.push(1);
+    queue.push(2);
+
+    int element = 0;
+    EXPECT_TRUE(queue.try_pop(element));
+    EXPECT_EQ(2, element);
+    EXPECT_EQ(1, queue.size());
+
+    EXPECT_TRUE(queue.try_pop(element));
+    EXPECT_EQ(1, element);
+    EXPECT_FALSE(queue.try_pop(element));
+    EXPECT_EQ(1, element);
+}
+
+TEST(TCircularQueue, try_operations_accept_move_only_elements)
+{
+    TCircularQueue<std::unique_ptr<int>> queue(1);
+
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(5)));
+    EXPECT_FALSE(queue.try_push(std::make_unique<int>(6)));
+
+    std::unique_ptr<int> element;
+    EXPECT_TRUE(queue.try_poll(element));
+    EXPECT_EQ(5, *element);
+}
+
+TEST(TCircularQueue, push_n_and_poll_n_wrap_around)
+{
+    TCircularQueue<int> queue(5);
+    const int input[] = { 1, 2, 3, 4, 5, 6, 7 };
+
+    EXPECT_EQ(3, queue.push_n(input, 3));
+    int output[7] = {};
+    EXPECT_EQ(2, queue.poll_n(output, 2));
+    EXPECT_EQ(1, output[0]);
+    EXPECT_EQ(2, output[1]);
+
+    // 3 is still queued, so only four more fit and the run wraps around
+    EXPECT_EQ(4, queue.push_n(input + 3, 4));
+    EXPECT_TRUE(queue.full());
+
+    EXPECT_EQ(5, queue.poll_n(output, 7));
+    for (int i = 0; i < 5; i++)
+        EXPECT_EQ(i + 3, output[i]);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(0, queue.poll_n(output, 7));
+}
+
+TEST(TCircularQueue, push_n_keeps_order_with_single_pushes)
+{
+    TCircularQueue<int> queue(4);
+    const int input[] = { 2, 3 };
+
+    queue.push(1);
+    queue.push_n(input, 2);
+    queue.push(4);
+
+    for (int i = 1; i <= 4; i++)
+        EXPECT_EQ(i, queue.poll());
+}
+
+TEST(TCircularQueue, spans_cover_queued_elements_in_order)
+{
+    TCircularQueue<int> queue(4);
+    const int input[] = { 1, 2, 3, 4, 5 };
+
+    queue.push_n(input, 3);
+    EXPECT_EQ(2, queue.shift_n(2));
+    queue.push_n(input + 3, 2);
+
+    std::vector<int> seen;
+    for (const auto& span : queue.spans())
+        seen.insert(seen.end(), span.begin(), span.end());
+
+    EXPECT_EQ(std::vector<int>({ 3, 4, 5 }), seen);
+    EXPECT_EQ(2, queue.spans()[0].size);
+    EXPECT_EQ(1, queue.spans()[1].size);
+}
+
+TEST(TCircularQueue, spans_of_empty_queue_are_empty)
+{
+    TCircularQueue<int> queue(3);
+
+    for (const auto& span : queue.spans())
+        EXPECT_EQ(0, span.size);
+}
+
+TEST(TCircularQueue, batch_operations_construct_and_destroy_elements)
+{
+    {
+        TCircularQueue<Counted> queue(3);
+        const Counted input[] = { Counted(1), Counted(2), Counted(3), Counted(4) };
+
+        EXPECT_EQ(3, queue.push_n(input, 4));
+        EXPECT_EQ(7, Counted::alive);
+
+        EXPECT_EQ(1, queue.shift_n(1));
+        EXPECT_EQ(6, Counted::alive);
+
+        EXPECT_EQ(1, queue.push_n(input + 3, 1));
+        Counted output[] = { Counted(0), Counted(0), Counted(0) };
+        EXPECT_EQ(3, queue.poll_n(output, 3));
+        EXPECT_EQ(2, output[0].value);
+        EXPECT_EQ(4, output[2].value);
+        EXPECT_EQ(7, Counted::alive);
+    }
+    EXPECT_EQ(0, Counted::alive);
+}
+
+TEST(TCircularQueue, power_of_two_queue_keeps_requested_capacity)
+{
+    TCircularQueue<int, true> queue(5);
+
+    for (int i = 0; i < 5; i++)
+        queue.push(i);
+
+    EXPECT_TRUE(queue.full());
+    EXPECT_EQ(5, queue.max_size());
+    EXPECT_THROW(queue.push(5), std::overflow_error);
+}
+
+TEST(TCircularQueue, power_of_two_queue_keeps_order_across_wrap_around)
+{
+    TCircularQueue<int, true> queue(3);
+
+    for (int i = 0; i < 100; i++)
+    {
+        queue.push(i);
+        queue.push(i + 1000);
+        EXPECT_EQ(i, queue.poll());
+        EXPECT_EQ(i + 1000, queue.top());
+        EXPECT_EQ(i + 1000, queue.pop_element());
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(TCircularQueue, power_of_two_queue_batches_wrap_around)
+{
+    TCircularQueue<int, true> queue(3);
+    const int input[] = { 1, 2, 3, 4 };
+
+    EXPECT_EQ(3, queue.push_n(input, 4));
+    EXPECT_EQ(2, queue.shift_n(2));
+    EXPECT_EQ(2, queue.push_n(input, 4));
+
+    std::vector<int> seen;
+    for (const auto& span : queue.spans())
+        seen.insert(seen.end(), span.begin(), span.end());
+    EXPECT_EQ(std::vector<int>({ 3, 1, 2 }), seen);
+
+    int output[3] = {};
+    EXPECT_EQ(3, queue.poll_n(output, 3));
+    EXPECT_EQ(2, output[2]);
+}
+
+TEST(TCircularQueue, can_copy_power_of_two_queue)
+{
+    TCircularQueue<int, true> queue(3);
+    queue.push(1);
+    queue.push(2);
+    queue.shift();
+    queue.push(3);
+    queue.push(4);
+
+    TCircularQueue<int, true> copy(queue);
+    EXPECT_EQ(2, copy.poll());
+    EXPECT_EQ(3, copy.poll());
+    EXPECT_EQ(4, copy.poll());
+    EXPECT_TRUE(copy.empty());
+}
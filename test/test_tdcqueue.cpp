@@ -0,0 +1,154 @@
+#include <gtest.h>
+#include "dcqueue.h"
+#include <memory>
+
+TEST(TDynamicCircularQueue, fresh_queue_is_empty)
+{
+    TDynamicCircularQueue<int> queue(4);
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.full());
+}
+
+TEST(TDynamicCircularQueue, throws_when_reading_empty_queue)
+{
+    TDynamicCircularQueue<int> queue(4);
+
+    EXPECT_THROW(queue.bottom(), std::logic_error);
+    EXPECT_THROW(queue.peek(), std::logic_error);
+    EXPECT_THROW(queue.shift(), std::logic_error);
+}
+
+TEST(TDynamicCircularQueue, grows_past_initial_capacity)
+{
+    TDynamicCircularQueue<int> queue(4);
+
+    for (int i = 0; i < 100; i++)
+        queue.push(i);
+
+    EXPECT_EQ(100, queue.size());
+    EXPECT_GE(queue.reserved(), 100);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(i, queue.poll());
+}
+
+TEST(TDynamicCircularQueue, keeps_order_when_growing_wrapped_ring)
+{
+    TDynamicCircularQueue<int> queue(4);
+    int next = 0, expected = 0;
+
+    // Every round wraps the ring before it runs out of slots
+    for (int round = 0; round < 10; round++)
+    {
+        for (int i = 0; i < 5; i++)
+            queue.push(next++);
+        for (int i = 0; i < 3; i++)
+            EXPECT_EQ(expected++, queue.poll());
+    }
+
+    while (!queue.empty())
+        EXPECT_EQ(expected++, queue.poll());
+    EXPECT_EQ(next, expected);
+}
+
+TEST(TDynamicCircularQueue, respects_soft_bound)
+{
+    TDynamicCircularQueue<int> queue(2, 5);
+
+    for (int i = 0; i < 5; i++)
+        queue.push(i);
+
+    EXPECT_TRUE(queue.full());
+    EXPECT_EQ(5, queue.max_size());
+    EXPECT_THROW(queue.push(5), std::overflow_error);
+    EXPECT_FALSE(queue.try_push(5));
+}
+
+TEST(TDynamicCircularQueue, shrinks_after_sustained_low_occupancy)
+{
+    TDynamicCircularQueue<int> queue(4);
+
+    for (int i = 0; i < 64; i++)
+        queue.push(i);
+    const size_t grown = queue.reserved();
+
+    while (queue.size() > 1)
+        queue.shift();
+    // Keep one element queued and churn it long enough to count as sustained
+    for (int i = 0; i < 1000; i++)
+    {
+        queue.push(i);
+        queue.shift();
+    }
+
+    EXPECT_LT(queue.reserved(), grown);
+    EXPECT_GE(queue.reserved(), 4);
+    EXPECT_EQ(999, queue.peek());
+}
+
+TEST(TDynamicCircularQueue, shrinks_when_drained_from_the_back)
+{
+    TDynamicCircularQueue<int> queue(4);
+
+    for (int i = 0; i < 64; i++)
+        queue.push(i);
+    const size_t grown = queue.reserved();
+
+    while (queue.size() > 1)
+        queue.pop();
+    // Every stack-style removal counts towards the shrink
+    for (int i = 0; i < 1000; i++)
+    {
+        queue.push(i);
+        if (i % 3 == 0)
+        {
+            queue.pop();
+        }
+        else if (i % 3 == 1)
+        {
+            EXPECT_EQ(i, queue.pop_element());
+        }
+        else
+        {
+            int element;
+            EXPECT_TRUE(queue.try_pop(element));
+        }
+    }
+
+    EXPECT_LT(queue.reserved(), grown);
+    EXPECT_GE(queue.reserved(), 4);
+    EXPECT_EQ(0, queue.peek());
+}
+
+TEST(TDynamicCircularQueue, does_not_shrink_below_initial_capacity)
+{
+    TDynamicCircularQueue<int> queue(16);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        queue.push(i);
+        queue.shift();
+    }
+
+    EXPECT_EQ(16, queue.reserved());
+}
+
+TEST(TDynamicCircularQueue, try_poll_reports_empty_queue)
+{
+    TDynamicCircularQueue<int> queue;
+    int element = 7;
+
+    EXPECT_FALSE(queue.try_poll(element));
+    EXPECT_EQ(7, element);
+    EXPECT_THROW(queue.shift(), std::logic_error);
+}
+
+TEST(TDynamicCircularQueue, can_hold_move_only_elements)
+{
+    TDynamicCircularQueue<std::unique_ptr<int>> queue(1);
+
+    for (int i = 0; i < 10; i++)
+        queue.emplace(new int(i));
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(i, *queue.poll());
+}
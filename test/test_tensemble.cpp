@@ -0,0 +1,67 @@
+#include <gtest.h>
+#include "ensemble.h"
+
+namespace
+{
+    template<size_t Words>
+    TPerfStat merged(const TEnsembleCluster<Words>& ensemble)
+    {
+        TPerfStat total;
+        for (const TPerfStat& stat : ensemble.stats())
+            total += stat;
+        return total;
+    }
+}
+
+TEST(TEnsembleCluster, can_create_ensemble)
+{
+    EXPECT_NO_THROW((TEnsembleCluster<>(8, 0.5, 0.5, 1)));
+}
+
+TEST(TEnsembleCluster, saturated_lanes_complete_task_every_cycle)
+{
+    TEnsembleCluster<> ensemble(4, 1.0, 1.0, 1);
+    ensemble.simulate(1000);
+
+    for (const TPerfStat& stat : ensemble.stats())
+    {
+        EXPECT_EQ(1000, stat.cycles);
+        EXPECT_EQ(1000, stat.completed_tasks);
+        EXPECT_EQ(0, stat.rejected_tasks);
+        EXPECT_EQ(0, stat.idle_cycles);
+    }
+}
+
+TEST(TEnsembleCluster, lanes_without_tasks_stay_idle)
+{
+    TEnsembleCluster<2> ensemble(4, 0.0, 0.5, 1);
+    ensemble.simulate(100);
+
+    EXPECT_EQ(128, ensemble.stats().size());
+    EXPECT_EQ(100, ensemble.stats(127).idle_cycles);
+}
+
+TEST(TEnsembleCluster, counts_survive_counter_flushes)
+{
+    TEnsembleCluster<> ensemble(1, 1.0, 0.0, 1);
+    ensemble.simulate(70000);
+
+    const TPerfStat stat = ensemble.stats(5);
+    EXPECT_EQ(70000, stat.total_tasks);
+    EXPECT_EQ(69998, stat.rejected_tasks);
+    EXPECT_EQ(0, stat.completed_tasks);
+}
+
+TEST(TEnsembleCluster, lanes_match_cluster_model)
+{
+    TEnsembleCluster<4> ensemble(5, 0.3, 0.35, 7);
+    ensemble.simulate(20000);
+
+    TCluster cluster(5, 0.3, 0.35, TRandom<double>(0.0, 1.0, 7));
+    cluster.simulate(20000 * 256);
+
+    const TPerfStat lanes = merged(ensemble);
+    EXPECT_NEAR(cluster.stats().idle_share(), lanes.idle_share(), 0.005);
+    EXPECT_NEAR(cluster.stats().rejection_share(), lanes.rejection_share(), 0.005);
+    EXPECT_NEAR(cluster.stats().service_cycles(), lanes.service_cycles(), 0.05);
+}
@@ -0,0 +1,65 @@
+#include <gtest.h>
+#include "histogram.h"
+
+TEST(TLatencyHistogram, empty_histogram_reports_zero)
+{
+    TLatencyHistogram histogram;
+
+    EXPECT_EQ(0, histogram.count());
+    EXPECT_EQ(0, histogram.p50());
+    EXPECT_EQ(0.0, histogram.mean());
+}
+
+TEST(TLatencyHistogram, small_values_are_exact)
+{
+    TLatencyHistogram histogram;
+    for (long long value = 1; value <= 100; value++)
+        histogram.record(value);
+
+    EXPECT_EQ(100, histogram.count());
+    EXPECT_EQ(1, histogram.min());
+    EXPECT_EQ(100, histogram.max());
+    EXPECT_DOUBLE_EQ(50.5, histogram.mean());
+    EXPECT_EQ(50, histogram.p50());
+    EXPECT_EQ(99, histogram.p99());
+    EXPECT_EQ(100, histogram.p999());
+}
+
+TEST(TLatencyHistogram, large_values_keep_relative_precision)
+{
+    TLatencyHistogram histogram;
+    for (long long value = 1; value <= 1000000; value++)
+        histogram.record(value * 1000);
+
+    const double precision = 1.0 / (1 << (TLatencyHistogram::SubBucketBits - 1));
+    EXPECT_NEAR(500000000.0, histogram.p50(), 500000000.0 * precision);
+    EXPECT_NEAR(990000000.0, histogram.p99(), 990000000.0 * precision);
+    EXPECT_NEAR(999000000.0, histogram.p999(), 999000000.0 * precision);
+    EXPECT_EQ(1000000000, histogram.max());
+}
+
+TEST(TLatencyHistogram, negative_values_are_recorded_as_zero)
+{
+    TLatencyHistogram histogram;
+    histogram.record(-5);
+
+    EXPECT_EQ(1, histogram.count());
+    EXPECT_EQ(0, histogram.max());
+}
+
+TEST(TLatencyHistogram, merged_histogram_counts_both)
+{
+    TLatencyHistogram first, second;
+    for (long long value = 0; value < 50; value++)
+    {
+        first.record(value);
+        second.record(value + 50);
+    }
+
+    first += second;
+
+    EXPECT_EQ(100, first.count());
+    EXPECT_EQ(0, first.min());
+    EXPECT_EQ(99, first.max());
+    EXPECT_EQ(49, first.p50());
+}
@@ -0,0 +1,30 @@
+#include <gtest.h>
+#include "linkedlist.h"
+
+TEST(TLinkedList, keeps_tail_after_removing_last_node)
+{
+    TLinkedList<int> list(4);
+    list.push_back(1);
+    list.push_back(2);
+    list.remove(1);
+    list.push_back(3);
+
+    EXPECT_EQ(3, list.back());
+    EXPECT_EQ(2, list.size());
+    EXPECT_EQ(3, list[1]);
+}
+
+TEST(TLinkedList, copied_list_is_equal_and_independent)
+{
+    TLinkedList<int> list;
+    for (int i = 0; i < 5; i++)
+        list.push_back(i);
+
+    TLinkedList<int> copy(list);
+    EXPECT_EQ(list, copy);
+
+    copy.push_back(5);
+    EXPECT_EQ(5, list.size());
+    EXPECT_EQ(4, list.back());
+    EXPECT_EQ(5, copy.back());
+}
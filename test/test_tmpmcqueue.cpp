@@ -0,0 +1,124 @@
+#include <gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "mpmcqueue.h"
+
+TEST(TMpmcQueue, can_create_queue)
+{
+    EXPECT_NO_THROW(TMpmcQueue<int> queue(8));
+}
+
+TEST(TMpmcQueue, fresh_queue_is_empty)
+{
+    TMpmcQueue<int> queue(1);
+    EXPECT_EQ(true, queue.empty());
+}
+
+TEST(TMpmcQueue, cant_poll_from_empty_queue)
+{
+    TMpmcQueue<int> queue(1);
+    int element;
+    EXPECT_EQ(false, queue.try_poll(element));
+    EXPECT_THROW((void) queue.poll(), std::logic_error);
+}
+
+TEST(TMpmcQueue, cant_push_to_full_queue)
+{
+    TMpmcQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+    EXPECT_EQ(true, queue.full());
+    EXPECT_EQ(false, queue.try_push(3));
+    EXPECT_THROW(queue.push(3), std::overflow_error);
+}
+
+TEST(TMpmcQueue, holds_elements_without_default_constructor)
+{
+    struct TTicket {
+        int id;
+        explicit TTicket(int id) : id(id) {}
+    };
+
+    TMpmcQueue<TTicket> queue(2);
+    queue.push(TTicket(1));
+    queue.push(TTicket(2));
+    EXPECT_EQ(1, queue.poll().id);
+    EXPECT_EQ(2, queue.poll().id);
+}
+
+TEST(TMpmcQueue, destroys_remaining_elements)
+{
+    auto shared = std::make_shared<int>(1);
+    {
+        TMpmcQueue<std::shared_ptr<int>> queue(4);
+        queue.push(shared);
+        queue.push(shared);
+        queue.push(shared);
+        (void) queue.poll();
+        EXPECT_EQ(3, shared.use_count());
+    }
+    EXPECT_EQ(1, shared.use_count());
+}
+
+TEST(TMpmcQueue, elements_placed_densely)
+{
+    TMpmcQueue<int> queue(3);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    EXPECT_EQ(1, queue.poll());
+    EXPECT_NO_THROW(queue.push(4));
+
+    EXPECT_EQ(2, queue.poll());
+    EXPECT_EQ(3, queue.poll());
+    EXPECT_EQ(4, queue.poll());
+}
+
+TEST(TMpmcQueue, delivers_every_element_once_between_threads)
+{
+    const int producers = 2, consumers = 2, count = 5000;
+    TMpmcQueue<int> queue(8);
+    std::atomic<long long> sum(0);
+    std::atomic<int> received(0);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&queue]() {
+            for (int i = 1; i <= count; )
+            {
+                if (queue.try_push(i))
+                    i++;
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++)
+    {
+        threads.emplace_back([&]() {
+            int element;
+            while (received.load() < producers * count)
+            {
+                if (queue.try_poll(element))
+                {
+                    sum += element;
+                    received++;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(producers * count, received.load());
+    EXPECT_EQ(producers * (count * (count + 1LL) / 2), sum.load());
+    EXPECT_EQ(true, queue.empty());
+}
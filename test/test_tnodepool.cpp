@@ -0,0 +1,41 @@
+#include <gtest.h>
+#include "nodepool.h"
+#include <limits>
+
+TEST(TNodePool, can_create_pool)
+{
+    EXPECT_NO_THROW(TNodePool<int> pool(8));
+}
+
+TEST(TNodePool, reserve_allocates_up_front)
+{
+    TNodePool<int> pool(100);
+    EXPECT_EQ(100, pool.capacity());
+
+    int *objects[100];
+    for (auto& object : objects)
+        object = pool.create(1);
+    for (auto& object : objects)
+        pool.destroy(object);
+
+    EXPECT_EQ(100, pool.capacity());
+}
+
+TEST(TNodePool, rejects_oversized_reservation)
+{
+    TNodePool<int> pool;
+    EXPECT_THROW(pool.reserve(std::numeric_limits<size_t>::max()), std::length_error);
+    EXPECT_EQ(0, pool.capacity());
+}
+
+TEST(TNodePool, released_storage_is_recycled)
+{
+    TNodePool<int> pool;
+    int *first = pool.create(1);
+    pool.destroy(first);
+
+    int *second = pool.create(2);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(2, *second);
+    pool.destroy(second);
+}
@@ -1,11 +1,30 @@
 #include <gtest.h>
 #include "queue.h"
+#include "arraylist.h"
+#include "ringlist.h"
+#include <limits>
+#include <memory>
 
 TEST(TQueue, can_create_queue)
 {
     EXPECT_NO_THROW(TQueue<int> queue(8));
 }
 
+TEST(TQueue, can_create_queue_with_huge_capacity)
+{
+    TQueue<int> unbounded(std::numeric_limits<size_t>::max());
+    TQueue<int> large(size_t(1) << 40);
+
+    for (int i = 0; i < 2000; i++)
+    {
+        unbounded.push(i);
+        large.push(i);
+    }
+    EXPECT_EQ(0, unbounded.poll());
+    EXPECT_EQ(0, large.poll());
+    EXPECT_EQ(1999, large.size());
+}
+
 TEST(TQueue, fresh_queue_is_empty)
 {
     TQueue<int> queue(1);
@@ -62,4 +81,133 @@ TEST(TQueue, memory_allocation_is_reliable)
     EXPECT_EQ(5, queue.poll());
     EXPECT_EQ(6, queue.poll());
     EXPECT_EQ(7, queue.poll());
-}
\ No newline at end of file
+}
+
+TEST(TQueue, array_backed_queue_keeps_order_across_compaction)
+{
+    TBaseQueue<int, TArrayList> queue(4);
+    int next = 0, expected = 0;
+
+    for (int round = 0; round < 100; round++)
+    {
+        while (!queue.full())
+            queue.push(next++);
+        EXPECT_EQ(expected++, queue.poll());
+        EXPECT_EQ(expected++, queue.poll());
+        EXPECT_EQ(expected++, queue.poll());
+    }
+
+    while (!queue.empty())
+        EXPECT_EQ(expected++, queue.poll());
+    EXPECT_EQ(next, expected);
+}
+
+TEST(TQueue, ring_backed_queue_keeps_order_across_wrap_around)
+{
+    TBaseQueue<int, TRingList> queue(5);
+    int next = 0, expected = 0;
+
+    for (int round = 0; round < 100; round++)
+    {
+        while (!queue.full())
+            queue.push(next++);
+        EXPECT_EQ(expected++, queue.poll());
+        EXPECT_EQ(expected++, queue.poll());
+        EXPECT_EQ(expected++, queue.poll());
+    }
+
+    while (!queue.empty())
+        EXPECT_EQ(expected++, queue.poll());
+    EXPECT_EQ(next, expected);
+}
+
+TEST(TQueue, can_hold_move_only_elements)
+{
+    TQueue<std::unique_ptr<int>> queue(2);
+    queue.push(std::unique_ptr<int>(new int(1)));
+    queue.emplace(new int(2));
+
+    EXPECT_EQ(1, *queue.poll());
+    EXPECT_EQ(2, *queue.poll());
+}
+
+TEST(TQueue, array_backed_queue_can_hold_move_only_elements)
+{
+    TBaseQueue<std::unique_ptr<int>, TArrayList> queue(4);
+    for (int i = 0; i < 4; i++)
+        queue.emplace(new int(i));
+
+    EXPECT_EQ(0, *queue.poll());
+    queue.push(std::unique_ptr<int>(new int(4)));
+
+    for (int i = 1; i <= 4; i++)
+        EXPECT_EQ(i, *queue.poll());
+}
+
+TEST(TQueue, try_push_reports_full_queue)
+{
+    TQueue<int> queue(2);
+
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_FALSE(queue.try_push(3));
+    EXPECT_EQ(2, queue.size());
+}
+
+TEST(TQueue, try_poll_reports_empty_queue)
+{
+    TBaseQueue<int, TArrayList> queue(4);
+    queue.push(7);
+
+    int element = 0;
+    EXPECT_TRUE(queue.try_poll(element));
+    EXPECT_EQ(7, element);
+    EXPECT_FALSE(queue.try_poll(element));
+    EXPECT_EQ(7, element);
+}
+
+TEST(TQueue, try_operations_do_not_throw_for_plain_elements)
+{
+    TQueue<long long> queue(4);
+    long long element;
+
+    EXPECT_TRUE(noexcept(queue.try_push(element)));
+    EXPECT_TRUE(noexcept(queue.try_poll(element)));
+}
+
+namespace
+{
+    // Copying never throws, but moving may
+    struct ThrowingMove
+    {
+        ThrowingMove() = default;
+        ThrowingMove(const ThrowingMove&) noexcept = default;
+        ThrowingMove(ThrowingMove&&) noexcept(false) {}
+        ThrowingMove& operator=(const ThrowingMove&) noexcept = default;
+        ThrowingMove& operator=(ThrowingMove&&) noexcept(false) { return *this; }
+    };
+}
+
+TEST(TQueue, try_push_may_throw_when_growing_moves_may_throw)
+{
+    TBaseQueue<ThrowingMove, TArrayList> queue(4);
+    TStack<ThrowingMove, TArrayList> stack(4);
+    const ThrowingMove element;
+
+    EXPECT_FALSE(noexcept(queue.try_push(element)));
+    EXPECT_FALSE(noexcept(stack.try_push(element)));
+}
+
+TEST(TQueue, stack_try_pop_takes_last_element)
+{
+    TStack<int, TLinkedList> stack;
+    EXPECT_TRUE(stack.try_push(1));
+    EXPECT_TRUE(stack.try_push(2));
+
+    int element = 0;
+    EXPECT_TRUE(stack.try_pop(element));
+    EXPECT_EQ(2, element);
+    EXPECT_TRUE(stack.try_pop(element));
+    EXPECT_FALSE(stack.try_pop(element));
+    EXPECT_EQ(1, element);
+}
@@ -0,0 +1,95 @@
+#include <gtest.h>
+#include "random.h"
+#include <cstdint>
+#include <random>
+
+namespace
+{
+    // Engine stuck at its largest output
+    struct TMaxEngine {
+        typedef uint32_t result_type;
+
+        explicit TMaxEngine(std::seed_seq&) {}
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return UINT32_MAX; }
+
+        result_type operator()() noexcept { return max(); }
+    };
+}
+
+TEST(TRandom, can_create_generator)
+{
+    EXPECT_NO_THROW((TRandom<double>(0.0, 1.0)));
+}
+
+TEST(TRandom, same_seed_gives_same_sequence)
+{
+    TRandom<double> first(0.0, 1.0, 42), second(0.0, 1.0, 42);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(first.next(), second.next());
+}
+
+TEST(TRandom, jump_starts_another_stream)
+{
+    TRandom<double> first(0.0, 1.0, 42), second(0.0, 1.0, 42);
+    second.jump();
+
+    int equal = 0;
+    for (int i = 0; i < 100; i++)
+        equal += first.next() == second.next();
+    EXPECT_EQ(0, equal);
+}
+
+TEST(TRandom, values_stay_in_range)
+{
+    TRandom<double> random(2.0, 3.0, 7);
+    for (int i = 0; i < 1000; i++)
+    {
+        const double value = random.next();
+        EXPECT_LE(2.0, value);
+        EXPECT_GT(3.0, value);
+    }
+}
+
+TEST(TRandom, bernoulli_follows_probability)
+{
+    TRandom<double> random(0.0, 1.0, 7);
+    const auto threshold = TRandom<double>::threshold(0.3);
+
+    int successes = 0;
+    for (int i = 0; i < 100000; i++)
+        successes += random.next_bernoulli(threshold);
+    EXPECT_NEAR(0.3, successes / 100000.0, 0.01);
+}
+
+TEST(TRandom, bernoulli_respects_certain_outcomes)
+{
+    TRandom<double> random(0.0, 1.0, 7);
+    const auto never = TRandom<double>::threshold(0.0);
+    const auto always = TRandom<double>::threshold(1.0);
+
+    bool ok = true;
+    for (int i = 0; i < 1000; i++)
+        ok &= !random.next_bernoulli(never) && random.next_bernoulli(always);
+    EXPECT_EQ(true, ok);
+}
+
+TEST(TRandom, mersenne_twister_engine_is_selectable)
+{
+    TRandom<double, std::mt19937> first(0.0, 1.0, 42), second(0.0, 1.0, 42);
+    EXPECT_EQ(first.next(), second.next());
+
+    const auto threshold = TRandom<double, std::mt19937>::threshold(0.5);
+    int successes = 0;
+    for (int i = 0; i < 10000; i++)
+        successes += first.next_bernoulli(threshold);
+    EXPECT_NEAR(0.5, successes / 10000.0, 0.03);
+}
+
+TEST(TRandom, bernoulli_is_certain_on_largest_engine_output)
+{
+    TRandom<double, TMaxEngine> random(0.0, 1.0, 7);
+    EXPECT_EQ(true, random.next_bernoulli(TRandom<double, TMaxEngine>::threshold(1.0)));
+    EXPECT_EQ(false, random.next_bernoulli(TRandom<double, TMaxEngine>::threshold(0.5)));
+}
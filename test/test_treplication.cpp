@@ -0,0 +1,52 @@
+#include <gtest.h>
+#include "replication.h"
+
+TEST(TReplicationRunner, runs_every_replication)
+{
+    TReplicationRunner<> runner(4, 0.4, 0.3, 1000);
+    const auto stats = runner.run(10, 42, 2);
+
+    EXPECT_EQ(10, stats.size());
+    for (const auto& stat : stats)
+        EXPECT_EQ(1000, stat.cycles);
+}
+
+TEST(TReplicationRunner, results_do_not_depend_on_thread_count)
+{
+    TReplicationRunner<> runner(4, 0.4, 0.3, 5000);
+    const auto single = runner.run(16, 42, 1);
+    const auto parallel = runner.run(16, 42, 4);
+
+    for (size_t i = 0; i < single.size(); i++)
+    {
+        EXPECT_EQ(single[i].total_tasks, parallel[i].total_tasks);
+        EXPECT_EQ(single[i].completed_tasks, parallel[i].completed_tasks);
+        EXPECT_EQ(single[i].idle_cycles, parallel[i].idle_cycles);
+    }
+}
+
+TEST(TReplicationRunner, replications_use_different_streams)
+{
+    TReplicationRunner<> runner(4, 0.4, 0.3, 5000);
+    const auto stats = runner.run(2, 42, 1);
+    EXPECT_NE(stats[0].total_tasks, stats[1].total_tasks);
+}
+
+TEST(TReplicationRunner, summary_merges_counters)
+{
+    TPerfStat first, second;
+    first.total_tasks = 10;
+    first.rejected_tasks = 2;
+    first.cycles = 100;
+    second.total_tasks = 30;
+    second.rejected_tasks = 6;
+    second.cycles = 100;
+
+    const auto summary = TReplicationRunner<>::summarize({ first, second });
+    EXPECT_EQ(2, summary.replications);
+    EXPECT_EQ(40, summary.total.total_tasks);
+    EXPECT_EQ(200, summary.total.cycles);
+    EXPECT_DOUBLE_EQ(20.0, summary.total_tasks.mean);
+    EXPECT_DOUBLE_EQ(0.2, summary.rejection_share.mean);
+    EXPECT_DOUBLE_EQ(0.0, summary.rejection_share.half_width);
+}
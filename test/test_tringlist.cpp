@@ -0,0 +1,140 @@
+#include <gtest.h>
+#include "ringlist.h"
+#include "queue.h"
+#include <memory>
+
+TEST(TRingList, cant_create_list_without_capacity)
+{
+    EXPECT_THROW(TRingList<int> list(0), std::invalid_argument);
+}
+
+TEST(TRingList, fresh_list_is_empty)
+{
+    TRingList<int> list(4);
+
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(0, list.size());
+}
+
+TEST(TRingList, keeps_order_at_both_ends)
+{
+    TRingList<int> list(4);
+
+    list.push_back(2);
+    list.push_front(1);
+    list.push_back(3);
+    list.push_front(0);
+
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(i, list[i]);
+    EXPECT_EQ(0, list.front());
+    EXPECT_EQ(3, list.back());
+
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(1, list.front());
+    EXPECT_EQ(2, list.back());
+}
+
+TEST(TRingList, grows_when_wrapped_around)
+{
+    TRingList<int> list(4);
+
+    // Leave the head in the middle of the buffer before it runs out
+    for (int i = 0; i < 3; i++)
+        list.push_back(i);
+    list.pop_front();
+    list.pop_front();
+    for (int i = 3; i < 20; i++)
+        list.push_back(i);
+    list.push_front(1);
+    list.push_front(0);
+
+    EXPECT_EQ(20, list.size());
+    for (int i = 0; i < 20; i++)
+        EXPECT_EQ(i, list[i]);
+}
+
+TEST(TRingList, shrink_keeps_elements_in_order)
+{
+    TRingList<int> list(4);
+    for (int i = 0; i < 64; i++)
+        list.push_back(i);
+    while (list.size() > 3)
+        list.pop_front();
+
+    list.shrink(0);
+
+    EXPECT_EQ(4, list.reserved());
+    for (int i = 0; i < 3; i++)
+        EXPECT_EQ(61 + i, list[i]);
+}
+
+TEST(TRingList, can_remove_from_both_halves)
+{
+    TRingList<int> list(8);
+    for (int i = 0; i < 6; i++)
+        list.push_front(5 - i);
+
+    list.remove(1);
+    list.remove(3);
+
+    const int expected[] = { 0, 2, 3, 5 };
+    ASSERT_EQ(4, list.size());
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(expected[i], list[i]);
+}
+
+TEST(TRingList, can_copy_and_compare_lists)
+{
+    TRingList<int> list(2);
+    list.push_back(2);
+    list.push_front(1);
+    list.push_back(3);
+
+    TRingList<int> copy(list);
+    EXPECT_EQ(list, copy);
+
+    copy.pop_back();
+    EXPECT_NE(list, copy);
+
+    copy = list;
+    EXPECT_EQ(list, copy);
+}
+
+TEST(TRingList, moved_from_list_stays_usable)
+{
+    TRingList<int> list(2);
+    list.push_back(1);
+
+    TRingList<int> moved(std::move(list));
+    list.push_back(2);
+
+    EXPECT_EQ(1, moved.front());
+    EXPECT_EQ(2, list.front());
+}
+
+TEST(TRingList, destroys_elements_exactly_once)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        TRingList<std::shared_ptr<int>> list(2);
+        for (int i = 0; i < 5; i++)
+            list.push_front(counter);
+        list.pop_back();
+        list.remove(1);
+        EXPECT_EQ(4, counter.use_count());
+    }
+    EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(TRingList, backs_stack)
+{
+    TStack<int, TRingList> stack(2);
+
+    for (int i = 0; i < 10; i++)
+        stack.push(i);
+    for (int i = 9; i >= 0; i--)
+        EXPECT_EQ(i, stack.pop_element());
+    EXPECT_TRUE(stack.empty());
+}
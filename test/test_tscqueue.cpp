@@ -0,0 +1,129 @@
+#include <gtest.h>
+#include "scqueue.h"
+#include <memory>
+#include <string>
+
+namespace
+{
+    constexpr int drain_sum()
+    {
+        TStaticCircularQueue<int, 4> queue;
+        int sum = 0;
+        for (int i = 1; i <= 10; i++)
+        {
+            queue.push(i);
+            if (queue.full())
+                sum += queue.poll();
+        }
+        while (!queue.empty())
+            sum += queue.poll();
+        return sum;
+    }
+}
+
+TEST(TStaticCircularQueue, can_be_used_in_constant_expressions)
+{
+    static_assert(drain_sum() == 55, "Queue should be usable at compile time");
+    EXPECT_EQ(55, drain_sum());
+}
+
+TEST(TStaticCircularQueue, keeps_slots_inline)
+{
+    EXPECT_GE(sizeof(TStaticCircularQueue<long long, 64>), 64 * sizeof(long long));
+    EXPECT_LT(sizeof(TStaticCircularQueue<long long, 64>), 65 * sizeof(long long) + 3 * sizeof(size_t));
+}
+
+TEST(TStaticCircularQueue, cant_create_queue_larger_than_slot_count)
+{
+    EXPECT_THROW((TStaticCircularQueue<int, 4>(5)), std::invalid_argument);
+    EXPECT_THROW((TStaticCircularQueue<int, 4>(0)), std::invalid_argument);
+}
+
+TEST(TStaticCircularQueue, keeps_requested_capacity)
+{
+    TStaticCircularQueue<int, 8> queue(3);
+
+    for (int i = 0; i < 3; i++)
+        queue.push(i);
+
+    EXPECT_TRUE(queue.full());
+    EXPECT_EQ(3, queue.max_size());
+    EXPECT_THROW(queue.push(3), std::overflow_error);
+    EXPECT_FALSE(queue.try_push(3));
+}
+
+TEST(TStaticCircularQueue, keeps_order_across_wrap_around)
+{
+    TStaticCircularQueue<int, 5> queue;
+    int next = 0, expected = 0;
+
+    for (int round = 0; round < 100; round++)
+    {
+        while (!queue.full())
+            queue.push(next++);
+        EXPECT_EQ(expected++, queue.poll());
+        EXPECT_EQ(expected++, queue.peek());
+        queue.shift();
+    }
+
+    EXPECT_EQ(next - 1, queue.top());
+    while (!queue.empty())
+        EXPECT_EQ(expected++, queue.poll());
+    EXPECT_EQ(next, expected);
+}
+
+TEST(TStaticCircularQueue, pop_removes_last_element)
+{
+    TStaticCircularQueue<int, 4> queue;
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    queue.pop();
+    EXPECT_EQ(2, queue.pop_element());
+    EXPECT_EQ(1, queue.bottom());
+    EXPECT_EQ(1, queue.size());
+}
+
+TEST(TStaticCircularQueue, try_poll_reports_empty_queue)
+{
+    TStaticCircularQueue<int, 2> queue;
+    int element = 7;
+
+    EXPECT_FALSE(queue.try_poll(element));
+    EXPECT_EQ(7, element);
+    EXPECT_THROW(queue.shift(), std::logic_error);
+}
+
+TEST(TStaticCircularQueue, destroys_elements_exactly_once)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        TStaticCircularQueue<std::shared_ptr<int>, 3> queue;
+        for (int i = 0; i < 5; i++)
+        {
+            queue.push(counter);
+            if (queue.full())
+                queue.shift();
+        }
+
+        TStaticCircularQueue<std::shared_ptr<int>, 3> copy(queue);
+        EXPECT_EQ(5, counter.use_count());
+
+        TStaticCircularQueue<std::shared_ptr<int>, 3> moved(std::move(copy));
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(5, counter.use_count());
+    }
+    EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(TStaticCircularQueue, can_hold_move_only_elements)
+{
+    TStaticCircularQueue<std::unique_ptr<std::string>, 2> queue;
+
+    for (int i = 0; i < 10; i++)
+    {
+        queue.emplace(new std::string(std::to_string(i)));
+        EXPECT_EQ(std::to_string(i), *queue.poll());
+    }
+}
@@ -0,0 +1,128 @@
+#include <gtest.h>
+#include <cstdint>
+#include <thread>
+#include "spscqueue.h"
+
+TEST(TSpscQueue, can_create_queue)
+{
+    EXPECT_NO_THROW(TSpscQueue<int> queue(8));
+}
+
+TEST(TSpscQueue, fresh_queue_is_empty)
+{
+    TSpscQueue<int> queue(1);
+    EXPECT_EQ(true, queue.empty());
+}
+
+TEST(TSpscQueue, cant_poll_from_empty_queue)
+{
+    TSpscQueue<int> queue(1);
+    EXPECT_ANY_THROW((void) queue.poll());
+}
+
+TEST(TSpscQueue, cant_push_to_full_queue)
+{
+    TSpscQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+    EXPECT_EQ(true, queue.full());
+    EXPECT_THROW(queue.push(3), std::overflow_error);
+}
+
+TEST(TSpscQueue, elements_placed_densely)
+{
+    TSpscQueue<int> queue(3);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    queue.shift();
+    EXPECT_NO_THROW(queue.push(4));
+
+    EXPECT_EQ(2, queue.peek());
+    EXPECT_EQ(2, queue.poll());
+    EXPECT_EQ(3, queue.poll());
+    EXPECT_EQ(4, queue.poll());
+}
+
+TEST(TSpscQueue, keeps_order_between_threads)
+{
+    const int count = 10000;
+    TSpscQueue<int> queue(16);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < count; )
+        {
+            if (queue.full())
+                std::this_thread::yield();
+            else
+                queue.push(i++);
+        }
+    });
+
+    bool ordered = true;
+    for (int i = 0; i < count; )
+    {
+        if (queue.empty())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered &= queue.poll() == i++;
+    }
+    producer.join();
+
+    EXPECT_EQ(true, ordered);
+    EXPECT_EQ(true, queue.empty());
+}
+
+TEST(TSpscQueue, try_push_and_try_poll_report_bounds)
+{
+    TSpscQueue<int> queue(2);
+    int element = 0;
+
+    EXPECT_FALSE(queue.try_poll(element));
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_FALSE(queue.try_push(3));
+    EXPECT_TRUE(queue.try_poll(element));
+    EXPECT_EQ(1, element);
+}
+
+TEST(TSpscQueue, buffer_starts_on_cache_line)
+{
+    TSpscQueue<char> queue(3);
+    queue.push('a');
+
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(&queue.peek()) % TSpscQueue<char>::CacheLineSize);
+}
+
+TEST(TSpscQueue, packed_queue_keeps_order_between_threads)
+{
+    const int count = 10000;
+    TSpscQueue<int, false> queue(4);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < count; )
+        {
+            if (queue.try_push(i))
+                i++;
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    bool ordered = true;
+    for (int i = 0; i < count; )
+    {
+        int element;
+        if (queue.try_poll(element))
+            ordered &= element == i++;
+        else
+            std::this_thread::yield();
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,104 @@
+#include <gtest.h>
+#include <sstream>
+#include "sweep.h"
+
+TEST(TSweep, parses_single_points)
+{
+    std::istringstream config("# capacity intensity performance cycles\n"
+                              "10 0.3 0.35 1000\n"
+                              "\n"
+                              "5 0.1 0.2 500 # short one\n");
+    const TSweep sweep = TSweep::parse(config);
+
+    ASSERT_EQ(2, sweep.get_points().size());
+    EXPECT_EQ(10, sweep.get_points()[0].capacity);
+    EXPECT_DOUBLE_EQ(0.1, sweep.get_points()[1].intensity);
+    EXPECT_EQ(500, sweep.get_points()[1].cycles);
+}
+
+TEST(TSweep, expands_lists_into_grid)
+{
+    std::istringstream config("5,10,20 0.1,0.3 0.35 1000,2000\n");
+    EXPECT_EQ(12, TSweep::parse(config).get_points().size());
+}
+
+TEST(TSweep, rejects_malformed_lines)
+{
+    std::istringstream missing("10 0.3 0.35\n");
+    EXPECT_THROW(TSweep::parse(missing), std::invalid_argument);
+
+    std::istringstream garbage("10 0.3x 0.35 100\n");
+    EXPECT_THROW(TSweep::parse(garbage), std::invalid_argument);
+}
+
+TEST(TSweep, rejects_negative_capacity)
+{
+    std::istringstream config("-1 0.3 0.35 1000\n");
+    EXPECT_THROW(TSweep::parse(config), std::invalid_argument);
+    std::istringstream listed("4,-2 0.3 0.35 1000\n");
+    EXPECT_THROW(TSweep::parse(listed), std::invalid_argument);
+}
+
+TEST(TSweep, results_do_not_depend_on_thread_count)
+{
+    std::istringstream config("2,4,8 0.2,0.5 0.3 2000,8000\n");
+    const TSweep sweep = TSweep::parse(config);
+
+    const auto single = sweep.run(7, 1);
+    const auto parallel = sweep.run(7, 3);
+
+    ASSERT_EQ(single.size(), parallel.size());
+    for (size_t i = 0; i < single.size(); i++)
+    {
+        EXPECT_EQ(single[i].point.capacity, parallel[i].point.capacity);
+        EXPECT_EQ(single[i].point.cycles, single[i].stat.cycles);
+        EXPECT_EQ(single[i].stat.total_tasks, parallel[i].stat.total_tasks);
+        EXPECT_EQ(single[i].stat.idle_cycles, parallel[i].stat.idle_cycles);
+    }
+}
+
+TEST(TSweep, writes_one_row_per_point)
+{
+    std::istringstream config("2,4 0.2 0.3 100\n");
+    const auto results = TSweep::parse(config).run(1, 1);
+
+    std::ostringstream csv;
+    TSweep::write_csv(csv, results);
+
+    int lines = 0;
+    for (char c : csv.str())
+        lines += c == '\n';
+    EXPECT_EQ(3, lines);
+}
+
+TEST(TSweep, solves_points_without_simulation)
+{
+    std::istringstream config("4,8 0.2,0.5 0.3 100000\n");
+    const TSweep sweep = TSweep::parse(config);
+
+    const auto results = sweep.solve();
+
+    ASSERT_EQ(4, results.size());
+    for (const TSweepResult& result : results)
+    {
+        EXPECT_EQ(100000, result.stat.cycles);
+        EXPECT_LE(result.stat.rejected_tasks, result.stat.total_tasks);
+    }
+}
+
+TEST(TSweep, solves_degenerate_points)
+{
+    std::istringstream config("0,4 0.5 0,0.5 1000\n");
+    const TSweep sweep = TSweep::parse(config);
+
+    std::vector<TSweepResult> results;
+    ASSERT_NO_THROW(results = sweep.solve());
+    ASSERT_EQ(4, results.size());
+
+    // Without a queue or without completions every task ends up rejected
+    for (const TSweepResult& result : results)
+    {
+        if (result.point.capacity == 0 || result.point.performance == 0.0)
+            EXPECT_EQ(result.stat.total_tasks, result.stat.rejected_tasks);
+    }
+}
@@ -0,0 +1,138 @@
+#include <gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "cluster.h"
+#include "trace.h"
+
+namespace
+{
+    const char* const TracePath = "test_trace.bin";
+
+    std::vector<TTraceRecord> read_all(const char* path)
+    {
+        std::vector<TTraceRecord> records;
+        TTraceReader reader(path);
+        TTraceRecord record;
+        while (reader.next(record))
+            records.push_back(record);
+        return records;
+    }
+}
+
+TEST(TTrace, reads_back_written_records)
+{
+    {
+        TTraceWriter writer(TracePath);
+        writer.record(TTraceEvent::Arrival, 1, 1);
+        writer.record(TTraceEvent::Start, 1, 1);
+        writer.record(TTraceEvent::Reject, 5, 2);
+        writer.record(TTraceEvent::Complete, 1000000000000LL, 1);
+    }
+
+    const auto records = read_all(TracePath);
+    std::remove(TracePath);
+
+    ASSERT_EQ(4, records.size());
+    EXPECT_EQ(TTraceEvent::Start, records[1].event);
+    EXPECT_EQ(5, records[2].cycle);
+    EXPECT_EQ(2, records[2].value);
+    EXPECT_EQ(TTraceEvent::Complete, records[3].event);
+    EXPECT_EQ(1000000000000LL, records[3].cycle);
+    EXPECT_EQ(1, records[3].value);
+}
+
+TEST(TTrace, merges_consecutive_idle_cycles)
+{
+    {
+        TTraceWriter writer(TracePath);
+        writer.record_idle(1, 1);
+        writer.record_idle(2, 1);
+        writer.record_idle(3, 4);
+        writer.record(TTraceEvent::Arrival, 7, 1);
+        writer.record_idle(9, 2);
+    }
+
+    const auto records = read_all(TracePath);
+    std::remove(TracePath);
+
+    ASSERT_EQ(3, records.size());
+    EXPECT_EQ(TTraceEvent::Idle, records[0].event);
+    EXPECT_EQ(1, records[0].cycle);
+    EXPECT_EQ(6, records[0].value);
+    EXPECT_EQ(TTraceEvent::Idle, records[2].event);
+    EXPECT_EQ(2, records[2].value);
+}
+
+TEST(TTrace, throws_on_record_after_close)
+{
+    {
+        TTraceWriter writer(TracePath, 0);
+        writer.record(TTraceEvent::Arrival, 1, 1);
+        writer.close();
+
+        // Enough records to fill the smallest buffer, which used to hang in submit()
+        for (int i = 0; i < 100; i++)
+            EXPECT_THROW(writer.record(TTraceEvent::Arrival, 2 + i, 2 + i), std::logic_error);
+        EXPECT_THROW(writer.record_idle(200, 1), std::logic_error);
+        EXPECT_NO_THROW(writer.close());
+    }
+
+    const auto records = read_all(TracePath);
+    std::remove(TracePath);
+
+    ASSERT_EQ(1, records.size());
+    EXPECT_EQ(1, records[0].cycle);
+}
+
+TEST(TTrace, rejects_foreign_file)
+{
+    {
+        std::ofstream file(TracePath);
+        file << "not a trace";
+    }
+
+    EXPECT_THROW(TTraceReader reader(TracePath), std::runtime_error);
+    std::remove(TracePath);
+}
+
+TEST(TTrace, traced_cluster_events_match_stats)
+{
+    TCluster cluster(3, 0.4, 0.3, TRandom<double>(0.0, 1.0, 5));
+    {
+        // A tiny buffer makes the writer thread swap buffers all the time
+        TTraceWriter writer(TracePath, 64);
+        cluster.set_tracer(&writer);
+        cluster.simulate(20000);
+        for (int i = 0; i < 20000; i++)
+        {
+            cluster.generate_tasks();
+            cluster.perform_cycle();
+        }
+        cluster.set_tracer(nullptr);
+    }
+
+    long long arrivals = 0, rejects = 0, starts = 0, completions = 0, idle = 0, lastCycle = 0;
+    for (const TTraceRecord& record : read_all(TracePath))
+    {
+        EXPECT_LE(lastCycle, record.cycle);
+        lastCycle = record.cycle;
+
+        switch (record.event)
+        {
+            case TTraceEvent::Arrival: arrivals++; break;
+            case TTraceEvent::Reject: rejects++; break;
+            case TTraceEvent::Start: starts++; break;
+            case TTraceEvent::Complete: completions++; break;
+            case TTraceEvent::Idle: idle += record.value; break;
+        }
+    }
+    std::remove(TracePath);
+
+    const auto& stat = cluster.stats();
+    EXPECT_EQ(stat.total_tasks, arrivals + rejects);
+    EXPECT_EQ(stat.rejected_tasks, rejects);
+    EXPECT_EQ(stat.completed_tasks, completions);
+    EXPECT_LE(completions, starts);
+    EXPECT_EQ(stat.idle_cycles, idle);
+}